@@ -52,11 +52,11 @@ void loop() {
   DOG.drawArrow(circle1_x, circle1_y, circle1_x+diff1_x, circle1_y-diff1_y);
   DOG.drawCircle(circle2_x, circle2_y, circle2_radius, false);
   DOG.drawArrow(circle2_x-diff2_x, circle2_y+diff2_y, circle2_x+diff2_x, circle2_y-diff2_y);
-  DOG.flushCanvas();
   String degree1_str(degree1);
-  DOG.string(18,5,DENSE_NUMBERS_8,degree1_str.c_str());
+  DOG.drawString(18,40,DENSE_NUMBERS_8,degree1_str.c_str());  // text is drawn into the canvas, so it is sent with the same flush
   String degree2_str(degree2);
-  DOG.string(85,6,DENSE_NUMBERS_8,degree2_str.c_str());
+  DOG.drawString(85,48,DENSE_NUMBERS_8,degree2_str.c_str());
+  DOG.flushCanvas();
   delay(100);
 
 }
@@ -0,0 +1,62 @@
+/******************************************************************************
+  Displays text lines scrolling from the bottom to the top like a log view.
+  The display is moved with its start line, so only the new row is drawn and sent.
+
+  Original Creation Date: Oct. 17, 2026
+
+  This code is Beerware; if you see me at the local,
+  and you've found our code helpful, please buy us a round!
+
+  Hardware Connections:
+  Connect DOGM128-6 to Arduino UNO. Use Hardware SPI.
+  SI    = 11 (Hardware SPI)
+  SCLK  = 13 (Hardware SPI)
+  CS    = 6
+  A0    = 8
+  RESET = 9
+  Backlight (if needed) is connected via a transistor to pin 10)
+
+  Distributed as-is; no warranty is given.
+******************************************************************************/
+#include <DogGraphicDisplay.h>
+#include "ubuntumono_b_16.h"
+
+#define BACKLIGHTPIN 10
+#define LINE_HEIGHT 16  // height of the font
+
+DogGraphicDisplay DOG;
+
+void setup() {
+  pinMode(BACKLIGHTPIN,  OUTPUT);   // set backlight pin to output
+  digitalWrite(BACKLIGHTPIN,  HIGH);  // enable backlight pin
+
+  DOG.begin(6,0,0,8,9,DOGM128);   //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  DOG.enableShadow(true);  // only bytes that really change are sent
+  DOG.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);  // Canvas in buffered mode
+}
+
+void loop() {
+  static int row=0;  // rows of the current line that are already visible
+  static unsigned long counter=0;
+  char text[16];
+  int y0, y1;
+
+  DOG.scrollBy(1);  // move everything one row up, the new row at the bottom is empty
+  if(DOG.getScrollArea(y0, y1))
+  {
+    sprintf(text, "Line %lu", counter);
+    DOG.pushClip(0, y0, 128, y1-y0+1);  // only draw the new row
+    DOG.drawString(0, 64-row-1, UBUNTUMONO_B_16, text);
+    DOG.popClip();
+  }
+  DOG.flushCanvas();
+
+  row++;
+  if(row>=LINE_HEIGHT)  // line is complete, start the next one
+  {
+    row=0;
+    counter++;
+  }
+
+  delay(25);  // wait a little bit
+}
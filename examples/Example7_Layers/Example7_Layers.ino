@@ -0,0 +1,62 @@
+/******************************************************************************
+  A ball moves over a static background. Background and ball are drawn into
+  their own canvases, the display puts them together while sending.
+  The background is drawn only once.
+
+  Original Creation Date: Oct. 17, 2026
+
+  This code is Beerware; if you see me at the local,
+  and you've found our code helpful, please buy us a round!
+
+  Hardware Connections:
+  Connect DOGM128-6 to Arduino UNO. Use Hardware SPI.
+  SI    = 11 (Hardware SPI)
+  SCLK  = 13 (Hardware SPI)
+  CS    = 6
+  A0    = 8
+  RESET = 9
+  Backlight (if needed) is connected via a transistor to pin 10)
+
+  Distributed as-is; no warranty is given.
+******************************************************************************/
+#include <DogGraphicDisplay.h>
+
+#define BACKLIGHTPIN 10
+#define BALL_SIZE 16  // width and height of the ball layer
+
+DogGraphicDisplay DOG;
+byte ballMemory[BALL_SIZE * BALL_SIZE / 8];
+DogCanvas ball(ballMemory, BALL_SIZE, BALL_SIZE);
+
+void setup() {
+  pinMode(BACKLIGHTPIN,  OUTPUT);   // set backlight pin to output
+  digitalWrite(BACKLIGHTPIN,  HIGH);  // enable backlight pin
+
+  DOG.begin(6,0,0,8,9,DOGM128);   //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  DOG.enableShadow(true);  // only bytes that really change are sent
+  DOG.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);  // background in buffered mode
+
+  for(int x = 0; x < 128; x += 8)  // background grid, drawn once
+    DOG.drawLine(x, 0, x, 63);
+  for(int y = 0; y < 64; y += 8)
+    DOG.drawLine(0, y, 127, y);
+
+  ball.drawCircle(BALL_SIZE/2, BALL_SIZE/2, BALL_SIZE/2-1, true);
+  DOG.addLayer(ball, 0, 0, ROP_XOR);  // ball inverts the background
+}
+
+void loop() {
+  static int x=0, dx=2;
+  static int page=0, dpage=1;
+
+  x += dx;
+  if(x <= 0 || x >= 128-BALL_SIZE) dx = -dx;  // bounce at the borders
+  if(x % 16 == 0)
+  {
+    page += dpage;
+    if(page <= 0 || page >= 8-BALL_SIZE/8) dpage = -dpage;
+  }
+  DOG.moveLayer(ball, x, page);  // layers are placed on whole pages
+  DOG.flushCanvas();  // background and ball are put together while sending
+  delay(20);
+}
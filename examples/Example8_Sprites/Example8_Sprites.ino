@@ -0,0 +1,55 @@
+/******************************************************************************
+  A cursor moves over a drawing without redrawing it. The sprite saves the
+  canvas below it and restores it when it moves, so only the old and the new
+  position are sent to the display.
+
+  Original Creation Date: Oct. 17, 2026
+
+  This code is Beerware; if you see me at the local,
+  and you've found our code helpful, please buy us a round!
+
+  Hardware Connections:
+  Connect DOGM128-6 to Arduino UNO. Use Hardware SPI.
+  SI    = 11 (Hardware SPI)
+  SCLK  = 13 (Hardware SPI)
+  CS    = 6
+  A0    = 8
+  RESET = 9
+  Backlight (if needed) is connected via a transistor to pin 10)
+
+  Distributed as-is; no warranty is given.
+******************************************************************************/
+#include <DogGraphicDisplay.h>
+
+#define BACKLIGHTPIN 10
+
+// BLH-pictures: width, height, then the data page by page
+const byte cursor_pic[] PROGMEM = {8, 8, 0x00, 0x7E, 0x42, 0x5A, 0x5A, 0x42, 0x7E, 0x00};
+const byte cursor_mask[] PROGMEM = {8, 8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+DogGraphicDisplay DOG;
+DogSprite cursor(cursor_pic, cursor_mask);
+
+void setup() {
+  pinMode(BACKLIGHTPIN,  OUTPUT);   // set backlight pin to output
+  digitalWrite(BACKLIGHTPIN,  HIGH);  // enable backlight pin
+
+  DOG.begin(6,0,0,8,9,DOGM128);   //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  DOG.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);  // Canvas in buffered mode
+
+  DOG.drawCircle(64, 32, 30, false);  // background, drawn once
+  DOG.drawCircle(64, 32, 20, false);
+  DOG.drawCross(64, 32, 128, 64);
+  cursor.show(DOG.getCanvas(), 0, 0);
+  DOG.flushCanvas();
+}
+
+void loop() {
+  static float angle=0.0;
+
+  angle+=0.05;
+  if(angle>=TWO_PI) angle-=TWO_PI;
+  cursor.moveTo(60+25*sin(angle), 28-25*cos(angle));  // background is restored, cursor drawn at the new position
+  DOG.flushCanvas();  // sends only the old and the new position
+  delay(20);
+}
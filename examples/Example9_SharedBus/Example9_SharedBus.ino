@@ -0,0 +1,53 @@
+/******************************************************************************
+  Two displays on one SPI bus. The bus starts the SPI port once and sends the
+  queued changes of both displays back to back.
+
+  Original Creation Date: Oct. 17, 2026
+
+  This code is Beerware; if you see me at the local,
+  and you've found our code helpful, please buy us a round!
+
+  Hardware Connections:
+  Connect two DOGM128-6 to Arduino UNO. Use Hardware SPI.
+  SI    = 11 (Hardware SPI, both displays)
+  SCLK  = 13 (Hardware SPI, both displays)
+  CS    = 6 (first display), 7 (second display)
+  A0    = 8 (both displays, ignored while CS is high)
+  RESET = 9 (first display), 5 (second display)
+  Backlight (if needed) is connected via a transistor to pin 10)
+
+  Distributed as-is; no warranty is given.
+******************************************************************************/
+#include <DogGraphicDisplay.h>
+
+#define BACKLIGHTPIN 10
+
+DogSpiBus bus(&SPI);
+DogGraphicDisplay left;
+DogGraphicDisplay right;
+
+void setup() {
+  pinMode(BACKLIGHTPIN,  OUTPUT);   // set backlight pin to output
+  digitalWrite(BACKLIGHTPIN,  HIGH);  // enable backlight pin
+
+  left.begin(bus, 6, 8, 9, DOGM128);   //CS = 6, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  right.begin(bus, 7, 8, 5, DOGM128);  //CS = 7, A0 is shared, own RESET = 5: begin resets the display
+  left.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);
+  right.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);
+}
+
+void loop() {
+  static int x=0;
+
+  left.clearCanvas();
+  left.drawLine(x, 0, 127-x, 63);
+  right.clearCanvas();
+  right.drawLine(127-x, 0, x, 63);
+  bus.queueFlush(left);
+  bus.queueFlush(right);
+  bus.flush();  // both displays are sent one after the other
+
+  x++;
+  if(x>127) x=0;
+  delay(20);
+}
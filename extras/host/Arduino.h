@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Stand-in for the Arduino core, used to build the library on a Linux host (see README.md).
+ * Pin changes are handed to the emulated controllers, time is taken from the host clock.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define MOSI 11  // pins of the hardware SPI port like on an UNO
+#define MISO 12
+#define SCK 13
+#define HOST_PINS 256  // count of emulated pins
+
+#define PROGMEM  // the host has one address space, program memory is read like RAM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+
+void pinMode (uint8_t pin, uint8_t mode);
+void digitalWrite (uint8_t pin, uint8_t val);
+int digitalRead (uint8_t pin);
+unsigned long millis (void);
+unsigned long micros (void);
+void delay (unsigned long ms);
+void delayMicroseconds (unsigned int us);
+long random (long howbig);
+long random (long howsmall, long howbig);
+void randomSeed (unsigned long seed);
+
+/*
+ * Byte stream like the Stream class of the Arduino core, without the functions of Print. See HostFile.h for a file on the host.
+ */
+class Stream
+{
+  public:
+    virtual ~Stream () {}
+    virtual int available (void) = 0;
+    virtual int read (void) = 0;
+    virtual int peek (void) = 0;
+    size_t readBytes (char *buffer, size_t length);
+    size_t readBytes (uint8_t *buffer, size_t length);
+};
+
+#endif
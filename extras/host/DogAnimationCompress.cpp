@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host tool: converts BLH-pictures of the same size (one file per frame) into an animation with key frames and frames that store
+ * only the changes to the previous frame, see DogAnimation.h. Build it from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include "DogConvert.h"
+
+int main(int argc, char *argv[])
+{
+  std::vector<unsigned char> picture, previous, current, out;
+  unsigned int width = 0, height = 0, frame_time, key_interval, keys = 0;
+  int frames = argc - 4;
+  size_t size = 0;
+  FILE *file;
+
+  if(argc < 5)
+  {
+    fprintf(stderr, "usage: %s NAME frame_ms key_interval frame0.h frame1.h ... > animation.h\n", argv[0]);
+    fprintf(stderr, "key_interval: a key frame every n frames, 0 = only when it is smaller than the changes\n");
+    return 2;
+  }
+  frame_time = strtoul(argv[2], NULL, 0);
+  key_interval = strtoul(argv[3], NULL, 0);
+  if(frames > 0xFFFF || frame_time > 0xFFFF)
+  {
+    fprintf(stderr, "at most 65535 frames of 65535 ms\n");
+    return 2;
+  }
+
+  for(int frame = 0; frame < frames; frame++)
+  {
+    const char *path = argv[4 + frame];
+
+    file = fopen(path, "r");
+    if(file == NULL)
+    {
+      fprintf(stderr, "%s can't be read\n", path);
+      return 2;
+    }
+    picture.clear();
+    if(!read_array(file, picture) || picture.size() < 2)
+    {
+      fprintf(stderr, "no picture array in %s\n", path);
+      fclose(file);
+      return 1;
+    }
+    fclose(file);
+
+    if(frame == 0)
+    {
+      width = picture[0];
+      height = picture[1];
+      size = (size_t)width * ((height + 7) / 8);  // width * pages
+      animation_header(out, width, height, frames, frame_time);
+    }
+    if(picture[0] != width || picture[1] != height || width == 0 || picture.size() < size + 2)
+    {
+      fprintf(stderr, "%s: all frames need %u x %u pixels and %u data bytes\n", path, width, height, (unsigned)size);
+      return 1;
+    }
+
+    current.assign(picture.begin() + 2, picture.begin() + 2 + size);
+    if(animation_frame(out, previous, current, width, key_interval > 0 && frame % key_interval == 0)) keys++;
+    previous = current;
+  }
+  if(out.size() > 0xFFFF)
+  {
+    fprintf(stderr, "animation of %u bytes is larger than 65535 bytes\n", (unsigned)out.size());
+    return 1;
+  }
+
+  printf("/* %s: %u frames of %u x %u pixels, %u key frames, compressed with DogAnimationCompress: %u bytes instead of %u */\n",
+         argv[1], frames, width, height, keys, (unsigned)out.size(), (unsigned)((size + 2) * frames));
+  printf("const byte %s[%u] PROGMEM = {", argv[1], (unsigned)out.size());
+  for(size_t i = 0; i < out.size(); i++)
+    printf("%s0x%02X", i % 16 ? ", " : (i ? ",\n  " : "\n  "), out[i]);
+  printf("\n};\n");
+  return 0;
+}
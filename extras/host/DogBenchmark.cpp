@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host benchmark: runs typical workloads on an emulated DOGM128-6 and prints what they cost as CSV table.
+ * With a budget file as argument the program fails if a workload sends more than its budget. Build and run it
+ * from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <DogGraphicDisplay.h>
+#include "DogEmulator.h"
+#include "DogConvert.h"
+#include "ubuntumono_b_16.h"
+#include "dense_numbers_8.h"
+
+#if !defined(DOG_STATS)
+#error "build the benchmark with -DDOG_STATS, it reads the counters of the display"
+#endif
+
+#define BENCH_MAX 32  // count of workloads
+#define ANIM_WIDTH 48  // frames of the animation workloads
+#define ANIM_PAGES 4
+#define ANIM_FRAMES 24
+
+struct BenchResult
+{
+  const char *name;
+  unsigned int iterations;
+  DogEmulatorStats stats;  // received by the controller
+  DogStats display;  // counted by the library
+  unsigned long time;  // microseconds of all iterations
+};
+
+DogEmulator EMU;
+DogGraphicDisplay DOG;
+BenchResult results[BENCH_MAX];
+byte resultCount = 0;
+unsigned long benchStart;
+byte checker[2 + 32 * 4];  // 32x32 picture
+byte animFrames[ANIM_FRAMES][2 + ANIM_WIDTH * ANIM_PAGES];  // BLH-pictures of the animation workloads
+std::vector<unsigned char> animation;  // the same frames as animation
+
+/*----------------------------
+Func: bench_start
+Desc: starts a workload, the counters are set to 0
+Vars: none
+------------------------------*/
+static void bench_start(void)
+{
+  EMU.resetStats();
+  DOG.resetStats();
+  benchStart = micros();
+}
+
+/*----------------------------
+Func: bench_stop
+Desc: stores the counters and the time of a workload
+Vars: name, count of iterations
+------------------------------*/
+static void bench_stop(const char *name, unsigned int iterations)
+{
+  if(resultCount >= BENCH_MAX) return;
+
+  BenchResult &result = results[resultCount];
+  result.time = micros() - benchStart;
+  result.name = name;
+  result.iterations = iterations;
+  result.stats = EMU.getStats();
+  result.display = DOG.getStats();
+  resultCount++;
+}
+
+/*----------------------------
+Func: gauges
+Desc: one frame of Example5: two turning arrows in circles with their angle as text
+Vars: frame number
+------------------------------*/
+static void gauges(int frame)
+{
+  char text[8];
+  float degree1 = frame * 1.0;
+  float degree2 = frame * 2.7;
+
+  DOG.clearCanvas();
+  DOG.drawCircle(32, 32, 31, false);
+  DOG.drawArrow(32, 32, 32 + 30 * sin(degree1 * DEG_TO_RAD), 32 - 30 * cos(degree1 * DEG_TO_RAD));
+  DOG.drawCircle(96, 20, 20, false);
+  DOG.drawArrow(96 - 19 * sin(degree2 * DEG_TO_RAD), 20 + 19 * cos(degree2 * DEG_TO_RAD),
+                96 + 19 * sin(degree2 * DEG_TO_RAD), 20 - 19 * cos(degree2 * DEG_TO_RAD));
+  snprintf(text, sizeof(text), "%d", (int)degree1 % 360);
+  DOG.drawString(18, 40, DENSE_NUMBERS_8, text);
+  snprintf(text, sizeof(text), "%d", (int)degree2 % 360);
+  DOG.drawString(85, 48, DENSE_NUMBERS_8, text);
+  DOG.flushCanvas();
+}
+
+/*----------------------------
+Func: animation_build
+Desc: draws the frames of the animation workloads, a box moves over a striped background, and converts them into an animation
+Vars: none
+------------------------------*/
+static void animation_build(void)
+{
+  std::vector<unsigned char> previous, current;
+
+  animation_header(animation, ANIM_WIDTH, ANIM_PAGES * 8, ANIM_FRAMES, 40);
+  for(int frame = 0; frame < ANIM_FRAMES; frame++)
+  {
+    DogCanvas canvas(&animFrames[frame][2], ANIM_WIDTH, ANIM_PAGES * 8);
+
+    animFrames[frame][0] = ANIM_WIDTH;
+    animFrames[frame][1] = ANIM_PAGES * 8;
+    canvas.clear();
+    for(int x = 0; x < ANIM_WIDTH; x += 6) canvas.drawLine(x, 0, x, ANIM_PAGES * 8 - 1);
+    canvas.drawRect(frame * (ANIM_WIDTH - 12) / (ANIM_FRAMES - 1), frame % 12 + 4, 12, 12, true);
+
+    current.assign(&animFrames[frame][2], &animFrames[frame][2] + ANIM_WIDTH * ANIM_PAGES);
+    animation_frame(animation, previous, current, ANIM_WIDTH, false);
+    previous = current;
+  }
+}
+
+/*----------------------------
+Func: animation_check
+Desc: compares the display RAM with the last frame of the animation
+Vars: name of the workload, column and page of the upper left corner
+------------------------------*/
+static void animation_check(const char *name, byte column, byte page)
+{
+  for(byte p = 0; p < ANIM_PAGES; p++)
+    for(byte c = 0; c < ANIM_WIDTH; c++)
+    {
+      if(EMU.getRam(column + c, page + p) != animFrames[ANIM_FRAMES - 1][2 + p * ANIM_WIDTH + c])
+      {
+        fprintf(stderr, "%s: display RAM is not the last frame at column %u page %u\n", name, column + c, page + p);
+        return;
+      }
+    }
+}
+
+/*----------------------------
+Func: run_workloads
+Desc: runs all workloads, each one starts with a cleared display
+Vars: none
+------------------------------*/
+static void run_workloads(void)
+{
+  int i;
+
+  bench_start();
+  DOG.begin(6, 0, 0, 8, 9, DOGM128);  //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  bench_stop("begin", 1);
+
+  bench_start();
+  for(i = 0; i < 10; i++) DOG.clear();
+  bench_stop("clear", 10);
+
+  bench_start();
+  for(i = 0; i < 10; i++) DOG.rectangle(0, 0, 127, 7, 0x55);
+  bench_stop("rectangle_full", 10);
+
+  bench_start();
+  for(i = 0; i < 10; i++)
+  {
+    DOG.picture(i * 8, 0, checker);
+    DOG.picture(i * 8, 4, checker, STYLE_INVERSE);
+  }
+  bench_stop("picture_32x32", 20);
+
+  bench_start();
+  for(i = 0; i < ANIM_FRAMES; i++) DOG.picture(40, 2, animFrames[i]);
+  bench_stop("animation_pictures", ANIM_FRAMES);
+  animation_check("animation_pictures", 40, 2);
+
+  DOG.clear();
+  DogAnimation player(animation.data());
+  player.setLoop(false);
+  bench_start();
+  player.start(DOG, 40, 2);
+  while(player.nextFrame());
+  bench_stop("animation_delta", ANIM_FRAMES);
+  animation_check("animation_delta", 40, 2);
+
+  DOG.clear();
+  bench_start();
+  for(i = 0; i < 360; i++)  // Example2: text moves over the whole width
+    DOG.string(DOG.display_width() - i, 3, UBUNTUMONO_B_16, "Hello to the scrolling World!");
+  bench_stop("string_scroll", 360);
+
+  bench_start();
+  for(i = 0; i < 10; i++)
+  {
+    DOG.string(0, 0, UBUNTUMONO_B_16, "0123456789ABCDEF", ALIGN_LEFT, STYLE_FULL);
+    DOG.string(0, 2, UBUNTUMONO_B_16, "GHIJKLMNOPQRSTUV", ALIGN_LEFT, STYLE_FULL);
+    DOG.string(0, 4, UBUNTUMONO_B_16, "abcdefghijklmnop", ALIGN_LEFT, STYLE_FULL);
+    DOG.string(0, 6, UBUNTUMONO_B_16, "qrstuvwxyz!?+-*/", ALIGN_LEFT, STYLE_FULL_INVERSE);
+  }
+  bench_stop("string_full_screen", 10);
+
+  DOG.clear();
+  DOG.createCanvas(128, 64, 0, 0, CANVAS_BUFFERED);
+  bench_start();
+  for(i = 0; i < 100; i++) gauges(i);
+  bench_stop("canvas_gauges", 100);
+
+  DOG.enableShadow(true);
+  bench_start();
+  for(i = 0; i < 100; i++) gauges(i);
+  bench_stop("canvas_gauges_shadow", 100);
+  DOG.enableShadow(false);
+
+  bench_start();
+  for(i = 0; i < 10; i++)
+  {
+    DOG.clearCanvas();
+    DOG.drawString(0, 0, UBUNTUMONO_B_16, "0123456789ABCDEF");
+    DOG.drawString(0, 16, UBUNTUMONO_B_16, "GHIJKLMNOPQRSTUV");
+    DOG.drawString(0, 32, UBUNTUMONO_B_16, "abcdefghijklmnop");
+    DOG.drawString(0, 48, UBUNTUMONO_B_16, "qrstuvwxyz!?+-*/", STYLE_INVERSE);
+    DOG.flushCanvas();
+  }
+  bench_stop("canvas_text_full_screen", 10);
+
+  bench_start();
+  for(i = 0; i < 10; i++)
+  {
+    DOG.clearCanvas();
+    DOG.drawRect(4 + i, 4, 40, 30, true);
+    DOG.drawCircle(80, 32 - i, 25, true);
+    DOG.drawRect(50, 40 + i, 70, 10, true);
+    DOG.flushCanvas();
+  }
+  bench_stop("canvas_filled_shapes", 10);
+
+  bench_start();
+  for(i = 0; i < 10; i++)
+  {
+    DOG.invalidateCanvas();
+    DOG.flushCanvas();
+  }
+  bench_stop("flush_full", 10);
+  DOG.deleteCanvas();
+}
+
+/*----------------------------
+Func: check_budget
+Desc: compares the results with a budget file, lines: workload,bytes,commands,selects (maximum of all iterations, # = comment)
+Vars: file name, returns the count of exceeded budgets or -1 if the file can't be read
+------------------------------*/
+static int check_budget(const char *path)
+{
+  FILE *file = fopen(path, "r");
+  char line[128], name[64];
+  unsigned long bytes, commands, selects;
+  int exceeded = 0;
+
+  if(file == NULL) return -1;
+  while(fgets(line, sizeof(line), file) != NULL)
+  {
+    if(line[0] == '#' || sscanf(line, "%63[^,],%lu,%lu,%lu", name, &bytes, &commands, &selects) != 4) continue;
+    for(byte i = 0; i < resultCount; i++)
+    {
+      if(strcmp(results[i].name, name) != 0) continue;
+      if(results[i].stats.bytes > bytes || results[i].stats.commands > commands || results[i].stats.selects > selects)
+      {
+        fprintf(stderr, "%s over budget: bytes %lu/%lu commands %lu/%lu selects %lu/%lu\n", name,
+                results[i].stats.bytes, bytes, results[i].stats.commands, commands, results[i].stats.selects, selects);
+        exceeded++;
+      }
+    }
+  }
+  fclose(file);
+  return exceeded;
+}
+
+int main(int argc, char *argv[])
+{
+  int exceeded;
+
+  animation_build();
+  checker[0] = 32;
+  checker[1] = 32;
+  for(int i = 0; i < 32 * 4; i++) checker[2 + i] = (i & 4) ? 0xF0 : 0x0F;
+
+  EMU.begin(6, 8, 9, DOGM128);
+  run_workloads();
+
+  printf("workload,iterations,bytes,commands,data,selects,a0_changes,positions,pixels,flushes,flush_us_max,errors,us_total,us_per_iteration\n");
+  for(byte i = 0; i < resultCount; i++)
+  {
+    BenchResult &result = results[i];
+    printf("%s,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%.1f\n", result.name, result.iterations, result.stats.bytes, result.stats.commands,
+           result.stats.data, result.stats.selects, result.stats.a0Changes, result.display.positions, result.display.pixels,
+           result.display.flushes, result.display.flushTimeMax, result.stats.errors, result.time, (double)result.time / result.iterations);
+    if(result.display.dataBytes != result.stats.data || result.display.commandBytes != result.stats.commands)
+      fprintf(stderr, "%s: library counted %lu data and %lu command bytes\n", result.name, result.display.dataBytes, result.display.commandBytes);
+  }
+
+  if(argc < 2) return 0;
+  exceeded = check_budget(argv[1]);
+  if(exceeded < 0)
+  {
+    fprintf(stderr, "budget file %s can't be read\n", argv[1]);
+    return 2;
+  }
+  return exceeded ? 1 : 0;
+}
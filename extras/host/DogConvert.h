@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Functions of the host programs that convert pictures: reading C arrays, run length encoding (see DogCanvas.h) and the frames of
+ * animations (see DogAnimation.h). Only included by programs that run on the host.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOG_CONVERT_H
+#define DOG_CONVERT_H
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define RUN_MAX 128  // bytes of one run, 7 bits in the control byte
+#define REPEAT_MIN 3  // shorter repeats are stored unchanged
+#define DELTA_GAP 3  // unchanged bytes stored in a delta run instead of a new run (3 bytes, 3 command bytes for the position)
+#define DELTA_RUN_MAX 255  // bytes of one delta run
+
+/*----------------------------
+Func: read_array
+Desc: reads the numbers of the first C array ({...}) of a file, decimal or hex
+Vars: file, vector for the bytes, returns false if there is no array or a number is larger than a byte
+------------------------------*/
+inline bool read_array(FILE *file, std::vector<unsigned char> &bytes)
+{
+  int c;
+  char number[16];
+  unsigned int len;
+  unsigned long value;
+
+  while((c = fgetc(file)) != EOF && c != '{');  // declaration before the data
+  if(c == EOF) return false;
+
+  while((c = fgetc(file)) != EOF && c != '}')
+  {
+    if(c == '/')  // comment inside the data
+    {
+      c = fgetc(file);
+      if(c == '/') while((c = fgetc(file)) != EOF && c != '\n');
+      else if(c == '*')
+      {
+        int last = 0;
+        while((c = fgetc(file)) != EOF && !(last == '*' && c == '/')) last = c;
+      }
+      continue;
+    }
+    if(!isdigit(c)) continue;
+    len = 0;
+    while(c != EOF && (isxdigit(c) || c == 'x' || c == 'X'))
+    {
+      if(len < sizeof(number) - 1) number[len++] = c;
+      c = fgetc(file);
+    }
+    number[len] = 0;
+    value = strtoul(number, NULL, 0);
+    if(value > 255) return false;
+    bytes.push_back(value);
+    if(c == '}') break;
+  }
+  return true;
+}
+
+/*----------------------------
+Func: compress
+Desc: run length encoding of the picture data like bitmap_next decodes it: control byte with bit 7 set: the next byte is
+      repeated (bits 0..6) + 1 times, else (bits 0..6) + 1 bytes follow unchanged
+Vars: data, vector for the compressed data
+------------------------------*/
+inline void compress(const std::vector<unsigned char> &data, std::vector<unsigned char> &out)
+{
+  size_t pos = 0, literal = 0, count = data.size(), run;
+
+  while(pos < count)
+  {
+    run = 1;
+    while(pos + run < count && run < RUN_MAX && data[pos + run] == data[pos]) run++;
+
+    if(run >= REPEAT_MIN)
+    {
+      out.push_back(0x80 | (run - 1));
+      out.push_back(data[pos]);
+      pos += run;
+      continue;
+    }
+
+    // bytes unchanged up to the next repeat
+    literal = 0;
+    while(pos + literal < count && literal < RUN_MAX)
+    {
+      run = 1;
+      while(pos + literal + run < count && run < REPEAT_MIN && data[pos + literal + run] == data[pos + literal]) run++;
+      if(run >= REPEAT_MIN) break;
+      literal++;
+    }
+    out.push_back(literal - 1);
+    for(size_t i = 0; i < literal; i++) out.push_back(data[pos + i]);
+    pos += literal;
+  }
+}
+
+/*----------------------------
+Func: animation_header
+Desc: starts an animation: 'A','N', width, height, frame count, time of a frame
+Vars: vector for the animation, width and height in pixels, count of frames, time of a frame in ms
+------------------------------*/
+inline void animation_header(std::vector<unsigned char> &out, unsigned int width, unsigned int height, unsigned int frames, unsigned int frame_time)
+{
+  out.push_back('A');
+  out.push_back('N');
+  out.push_back(width);
+  out.push_back(height);
+  out.push_back(frames & 0xFF);
+  out.push_back(frames >> 8);
+  out.push_back(frame_time & 0xFF);
+  out.push_back(frame_time >> 8);
+}
+
+/*----------------------------
+Func: animation_delta
+Desc: stores the changes to the previous frame as runs: page, column, length, XOR of the bytes. Runs that are separated by
+      DELTA_GAP or less unchanged bytes are stored as one run, it costs less than a new position.
+Vars: previous and current frame (width * pages bytes), width, vector for the frame
+------------------------------*/
+inline void animation_delta(const std::vector<unsigned char> &previous, const std::vector<unsigned char> &current, unsigned int width,
+                            std::vector<unsigned char> &out)
+{
+  size_t pages = current.size() / width;
+  unsigned int column, start, end, next;
+
+  out.push_back('D');  // ANIMATION_DELTA
+  for(size_t page = 0; page < pages; page++)
+  {
+    const unsigned char *prev = &previous[page * width], *cur = &current[page * width];
+
+    for(column = 0; column < width; )
+    {
+      if(prev[column] == cur[column])
+      {
+        column++;
+        continue;
+      }
+      start = column;
+      end = column;  // last changed byte of the run
+      for(next = column + 1; next < width && next - start < DELTA_RUN_MAX && next - end <= DELTA_GAP + 1; next++)
+      {
+        if(prev[next] != cur[next]) end = next;
+      }
+      out.push_back(page);
+      out.push_back(start);
+      out.push_back(end - start + 1);
+      for(column = start; column <= end; column++) out.push_back(prev[column] ^ cur[column]);
+    }
+  }
+  out.push_back(0xFF);  // ANIMATION_END
+}
+
+/*----------------------------
+Func: animation_frame
+Desc: adds a frame to an animation, as key frame if it is the first one, if key is set or if it is smaller than the delta frame
+Vars: vector for the animation, previous (ignored for the first frame) and current frame (width * pages bytes), width,
+      store as key frame, returns true if a key frame was stored
+------------------------------*/
+inline bool animation_frame(std::vector<unsigned char> &out, const std::vector<unsigned char> &previous, const std::vector<unsigned char> &current,
+                            unsigned int width, bool key)
+{
+  std::vector<unsigned char> delta, whole;
+
+  whole.push_back('K');  // ANIMATION_KEY
+  compress(current, whole);
+  if(!key && previous.size() == current.size())
+  {
+    animation_delta(previous, current, width, delta);
+    if(delta.size() <= whole.size())
+    {
+      out.insert(out.end(), delta.begin(), delta.end());
+      return false;
+    }
+  }
+  out.insert(out.end(), whole.begin(), whole.end());
+  return true;
+}
+
+#endif
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Emulated ST7565/UC1701 controller for the Linux host build.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include "DogEmulator.h"
+#include "DogGraphicDisplay.h"
+
+DogEmulator *DogEmulator::emulators[DOG_EMU_MAX];
+
+/*-----------------------------
+constructor, the emulator is connected by begin
+*/
+DogEmulator::DogEmulator(void)
+{
+  port = NULL;
+  p_cs = p_a0 = p_res = p_si = p_clk = 0;
+  screenWidth = screenHeight = topOffset = 0;
+  memset(ram, 0, sizeof(ram));
+  resetStats();
+  reset();
+}
+
+/*-----------------------------
+destructor, disconnects the emulator
+*/
+DogEmulator::~DogEmulator()
+{
+  end();
+}
+
+/*----------------------------
+Func: begin
+Desc: connects the emulator to the hardware SPI port SPI
+Vars: CS-Pin, A0-Pin, Reset-Pin, type (DOGM128, DOGL128, DOGM132, DOGS102) for the size of the glass
+------------------------------*/
+void DogEmulator::begin(byte p_cs, byte p_a0, byte p_res, byte type)
+{
+  attach(&SPI, p_cs, 0, 0, p_a0, p_res, type);
+}
+
+/*----------------------------
+Func: begin
+Desc: connects the emulator to a hardware SPI port
+Vars: Spi-Port, CS-Pin, A0-Pin, Reset-Pin, type
+------------------------------*/
+void DogEmulator::begin(SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type)
+{
+  attach(port, p_cs, 0, 0, p_a0, p_res, type);
+}
+
+/*----------------------------
+Func: begin
+Desc: connects the emulator to bit bang SPI, the data pin is read at the rising edge of the clock pin
+Vars: CS-Pin, MOSI-Pin, SCK-Pin, A0-Pin, Reset-Pin, type
+------------------------------*/
+void DogEmulator::begin(byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type)
+{
+  attach(NULL, p_cs, p_si, p_clk, p_a0, p_res, type);
+}
+
+/*----------------------------
+Func: end
+Desc: disconnects the emulator, the RAM keeps its content
+Vars: none
+------------------------------*/
+void DogEmulator::end(void)
+{
+  for(byte i = 0; i < DOG_EMU_MAX; i++)
+  {
+    if(emulators[i] == this) emulators[i] = NULL;
+  }
+}
+
+/*----------------------------
+Func: reset
+Desc: hardware reset like a low level on the reset pin: display off, start line, column and page 0, ADC and common output normal.
+      The RAM keeps its content.
+Vars: none
+------------------------------*/
+void DogEmulator::reset(void)
+{
+  column = 0;
+  page = 0;
+  startLine = 0;
+  rmw = false;
+  rmwColumn = 0;
+  adcReverse = false;
+  comReverse = false;
+  inverse = false;
+  allOn = false;
+  displayOn = false;
+  pendingCommand = 0;
+  shift = 0;
+  bits = 0;
+}
+
+/*----------------------------
+Func: getRam
+Desc: returns a byte of the display RAM
+Vars: column (0..131), page (0..8)
+------------------------------*/
+byte DogEmulator::getRam(byte column, byte page)
+{
+  if(column >= DOG_EMU_COLUMNS || page >= DOG_EMU_PAGES) return 0;
+  return ram[page][column];
+}
+
+/*----------------------------
+Func: getPixel
+Desc: returns a pixel of the glass like it is seen in the view the controller is set to (start line, ADC, common output direction,
+      inverse, all pixels on and display off). x=0, y=0 is the upper left corner, like the coordinates of the library.
+Vars: x, y on the glass
+------------------------------*/
+bool DogEmulator::getPixel(int x, int y)
+{
+  int ram_column, line;
+  bool pixel;
+
+  if(x < 0 || x >= screenWidth || y < 0 || y >= screenHeight) return false;
+  if(!displayOn) return false;
+  if(allOn) return true;
+
+  if(adcReverse == comReverse) x = screenWidth - 1 - x;  // ADC and common output don't belong to the same view, picture is mirrored
+  ram_column = adcReverse ? x : x + topOffset;  // ADC normal (top view) uses the upper columns of the RAM
+  line = (startLine + y) % (DOG_EMU_LINES - 1);
+  pixel = (ram[line >> 3][ram_column] >> (line & 7)) & 1;
+  return pixel != inverse;
+}
+
+/*----------------------------
+Func: getStartLine
+Desc: returns the display start line
+Vars: none
+------------------------------*/
+byte DogEmulator::getStartLine(void)
+{
+  return startLine;
+}
+
+/*----------------------------
+Func: getColumn
+Desc: returns the column address, it is incremented by every data byte
+Vars: none
+------------------------------*/
+byte DogEmulator::getColumn(void)
+{
+  return column;
+}
+
+/*----------------------------
+Func: getPage
+Desc: returns the page address
+Vars: none
+------------------------------*/
+byte DogEmulator::getPage(void)
+{
+  return page;
+}
+
+/*----------------------------
+Func: isDisplayOn
+Desc: returns true if the display was switched on (0xAF)
+Vars: none
+------------------------------*/
+bool DogEmulator::isDisplayOn(void)
+{
+  return displayOn;
+}
+
+/*----------------------------
+Func: writeRamPBM
+Desc: writes the whole display RAM (132 x 65, RAM line 0 on top) as plain PBM file, a set bit is black
+Vars: file name, returns false if the file can't be written
+------------------------------*/
+bool DogEmulator::writeRamPBM(const char *path)
+{
+  FILE *file = fopen(path, "w");
+
+  if(file == NULL) return false;
+  fprintf(file, "P1\n%d %d\n", DOG_EMU_COLUMNS, DOG_EMU_LINES);
+  for(int line = 0; line < DOG_EMU_LINES; line++)
+  {
+    for(int x = 0; x < DOG_EMU_COLUMNS; x++)
+      fputc((ram[line >> 3][x] >> (line & 7)) & 1 ? '1' : '0', file);
+    fputc('\n', file);
+  }
+  return fclose(file) == 0;
+}
+
+/*----------------------------
+Func: writeScreenPBM
+Desc: writes what the glass shows (see getPixel) as plain PBM file
+Vars: file name, returns false if the file can't be written
+------------------------------*/
+bool DogEmulator::writeScreenPBM(const char *path)
+{
+  FILE *file = fopen(path, "w");
+
+  if(file == NULL) return false;
+  fprintf(file, "P1\n%d %d\n", screenWidth, screenHeight);
+  for(int y = 0; y < screenHeight; y++)
+  {
+    for(int x = 0; x < screenWidth; x++)
+      fputc(getPixel(x, y) ? '1' : '0', file);
+    fputc('\n', file);
+  }
+  return fclose(file) == 0;
+}
+
+/*----------------------------
+Func: getStats
+Desc: returns the counters since the last resetStats
+Vars: none
+------------------------------*/
+DogEmulatorStats DogEmulator::getStats(void)
+{
+  return stats;
+}
+
+/*----------------------------
+Func: resetStats
+Desc: sets all counters to 0
+Vars: none
+------------------------------*/
+void DogEmulator::resetStats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+/*----------------------------
+Func: pin_changed
+Desc: called by digitalWrite, hands the new level to the emulators that use the pin
+Vars: pin, level
+------------------------------*/
+void DogEmulator::pin_changed(byte pin, byte level)
+{
+  DogEmulator *emu;
+
+  for(byte i = 0; i < DOG_EMU_MAX; i++)
+  {
+    emu = emulators[i];
+    if(emu == NULL) continue;
+    if(pin == emu->p_res && level == LOW) emu->reset();
+    if(pin == emu->p_cs && level == LOW)
+    {
+      emu->stats.selects++;
+      emu->bits = 0;  // a byte starts with the selection
+    }
+    if(digitalRead(emu->p_cs) != LOW) continue;
+    if(pin == emu->p_a0) emu->stats.a0Changes++;
+    if(emu->port == NULL && pin == emu->p_clk && level == HIGH)  // bit bang SPI, MSB first
+    {
+      emu->shift = (emu->shift << 1) | digitalRead(emu->p_si);
+      if(++emu->bits == 8)
+      {
+        emu->bits = 0;
+        emu->receive(emu->shift);
+      }
+    }
+  }
+}
+
+/*----------------------------
+Func: spi_received
+Desc: called by SPIClass::transfer, hands the byte to the selected emulators on the port. The controller reads MSB first in SPI
+      mode 0 or 3, bytes sent LSB first are received mirrored.
+Vars: port, data
+------------------------------*/
+void DogEmulator::spi_received(SPIClass *port, byte dat)
+{
+  DogEmulator *emu;
+  SPISettings settings = port->getSettings();
+  byte received = dat;
+
+  if(settings.bitOrder == LSBFIRST)
+  {
+    received = 0;
+    for(byte bit = 0; bit < 8; bit++)
+      if(dat & (1 << bit)) received |= 0x80 >> bit;
+  }
+
+  for(byte i = 0; i < DOG_EMU_MAX; i++)
+  {
+    emu = emulators[i];
+    if(emu == NULL || emu->port != port || digitalRead(emu->p_cs) != LOW) continue;
+    if(!port->isStarted() || !port->inTransaction() || settings.dataMode == SPI_MODE1 || settings.dataMode == SPI_MODE2)
+      emu->stats.errors++;
+    emu->receive(received);
+  }
+}
+
+//----------------------------------------------------private Functions----------------------------------------------------
+
+/*----------------------------
+Func: attach
+Desc: stores the pins and the size of the glass and adds the emulator to the list that gets the pin changes and SPI bytes
+Vars: port (NULL = bit bang), pins, type
+------------------------------*/
+void DogEmulator::attach(SPIClass *port, byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type)
+{
+  byte free_slot = DOG_EMU_MAX;
+
+  this->port = port;
+  this->p_cs = p_cs;
+  this->p_si = p_si;
+  this->p_clk = p_clk;
+  this->p_a0 = p_a0;
+  this->p_res = p_res;
+  screenWidth = (type == DOGM132) ? 132 : ((type == DOGS102) ? 102 : 128);
+  screenHeight = (type == DOGM132) ? 32 : 64;
+  topOffset = (type == DOGM132) ? 0 : 4;  // like view of the display
+
+  for(byte i = 0; i < DOG_EMU_MAX; i++)
+  {
+    if(emulators[i] == this) return;
+    if(emulators[i] == NULL && free_slot == DOG_EMU_MAX) free_slot = i;
+  }
+  if(free_slot < DOG_EMU_MAX) emulators[free_slot] = this;
+}
+
+/*----------------------------
+Func: receive
+Desc: handles a byte with the level of A0: command or data
+Vars: data
+------------------------------*/
+void DogEmulator::receive(byte dat)
+{
+  stats.bytes++;
+  if(digitalRead(p_a0) == HIGH)
+  {
+    stats.data++;
+    data(dat);
+  }
+  else
+  {
+    stats.commands++;
+    command(dat);
+  }
+}
+
+/*----------------------------
+Func: command
+Desc: decodes a command byte of the ST7565/UC1701, commands without effect on the picture (power, bias, contrast) are accepted and ignored
+Vars: command
+------------------------------*/
+void DogEmulator::command(byte cmd)
+{
+  if(pendingCommand != 0)  // second byte: contrast, static indicator, booster ratio, advanced program control
+  {
+    pendingCommand = 0;
+    return;
+  }
+
+  if(cmd <= 0x0F) column = (column & 0xF0) | cmd;  // column address LSB
+  else if(cmd <= 0x1F) column = (column & 0x0F) | ((cmd & 0x0F) << 4);  // column address MSB
+  else if(cmd >= 0x40 && cmd <= 0x7F) startLine = cmd & 0x3F;
+  else if(cmd >= 0xB0 && cmd <= 0xBF) page = cmd & 0x0F;
+  else if(cmd >= 0xC0 && cmd <= 0xCF) comReverse = (cmd & 0x08) != 0;
+  else if(cmd == 0x81 || cmd == 0xAC || cmd == 0xAD || cmd == 0xF8 || cmd == 0xFA) pendingCommand = cmd;
+  else if(cmd == 0xA0 || cmd == 0xA1) adcReverse = cmd & 0x01;
+  else if(cmd == 0xA4 || cmd == 0xA5) allOn = cmd & 0x01;
+  else if(cmd == 0xA6 || cmd == 0xA7) inverse = cmd & 0x01;
+  else if(cmd == 0xAE || cmd == 0xAF) displayOn = cmd & 0x01;
+  else if(cmd == 0xE0)  // read-modify-write: column is restored by 0xEE
+  {
+    rmw = true;
+    rmwColumn = column;
+  }
+  else if(cmd == 0xEE)
+  {
+    if(rmw) column = rmwColumn;
+    rmw = false;
+  }
+  else if(cmd == 0xE2)  // internal reset
+  {
+    column = 0;
+    page = 0;
+    startLine = 0;
+    comReverse = false;
+    rmw = false;
+  }
+}
+
+/*----------------------------
+Func: data
+Desc: writes a data byte at the column and page address, the column address is incremented and stops after the last column
+Vars: data
+------------------------------*/
+void DogEmulator::data(byte dat)
+{
+  if(column >= DOG_EMU_COLUMNS) return;
+  if(page < DOG_EMU_PAGES) ram[page][column] = dat;
+  column++;
+}
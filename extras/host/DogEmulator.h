@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Emulated ST7565/UC1701 controller for the Linux host build (see README.md).
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGEMULATOR_H
+#define DOGEMULATOR_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define DOG_EMU_COLUMNS 132  // display RAM of the controller: 132 columns x 65 lines
+#define DOG_EMU_PAGES 9  // page 8 only has line 64 (icons) in bit 0
+#define DOG_EMU_LINES 65
+#define DOG_EMU_MAX 4  // count of emulators that can be connected at the same time
+
+/*
+ * Counts what the controller received, a base for measuring what the functions of the library cost.
+ * Errors are bytes sent outside of a transaction or with a SPI mode the controller can't read (SPI_MODE1, SPI_MODE2).
+ */
+struct DogEmulatorStats
+{
+  unsigned long bytes;  // all bytes received with CS low
+  unsigned long commands;  // bytes with A0 low
+  unsigned long data;  // bytes with A0 high
+  unsigned long selects;  // falling edges of CS
+  unsigned long a0Changes;  // level changes of A0 while CS is low
+  unsigned long errors;
+};
+
+/*
+ * The emulator listens to the pins and the SPI port like the controller on the panel: it decodes the command bytes
+ * (column, page, start line, ADC, common output direction, inverse, all pixels on, display on/off, reset, read-modify-write
+ * and the double byte commands of the init tables) and writes the data bytes into its display RAM.
+ * Hardware SPI is read from a SPIClass, bit bang SPI from the rising edges of the clock pin.
+ */
+class DogEmulator
+{
+  public:
+    DogEmulator (void);
+    ~DogEmulator ();
+    void begin (byte p_cs, byte p_a0, byte p_res, byte type);
+    void begin (SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type);
+    void begin (byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type);
+    void end (void);
+    void reset (void);
+    byte getRam (byte column, byte page);
+    bool getPixel (int x, int y);
+    byte getStartLine (void);
+    byte getColumn (void);
+    byte getPage (void);
+    bool isDisplayOn (void);
+    bool writeRamPBM (const char *path);
+    bool writeScreenPBM (const char *path);
+    DogEmulatorStats getStats (void);
+    void resetStats (void);
+
+    static void pin_changed (byte pin, byte level);
+    static void spi_received (SPIClass *port, byte dat);
+
+  private:
+    SPIClass *port;  // NULL = bit bang SPI
+    byte p_cs, p_a0, p_res, p_si, p_clk;
+    byte screenWidth, screenHeight, topOffset;  // glass of the panel, column offset with ADC normal
+    byte ram[DOG_EMU_PAGES][DOG_EMU_COLUMNS];
+    byte column, page, startLine;
+    byte rmwColumn;  // column when read-modify-write started
+    bool rmw;
+    bool adcReverse, comReverse, inverse, allOn, displayOn;
+    byte pendingCommand;  // first byte of a double byte command, 0 = none
+    byte shift, bits;  // bit bang SPI
+    DogEmulatorStats stats;
+
+    static DogEmulator *emulators[DOG_EMU_MAX];
+
+    void attach (SPIClass *port, byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type);
+    void receive (byte dat);
+    void command (byte cmd);
+    void data (byte dat);
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host test of flushCanvasAsync on an emulated DOGM128-6: a simulated backend finishes every page after a few polls,
+ * the next frame is drawn into the second buffer while the last one is sent. The display RAM is compared with the
+ * flushed frames. Build and run it from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include <DogGraphicDisplay.h>
+#include "DogEmulator.h"
+
+#define PIN_CS 6
+#define PIN_A0 8
+#define PIN_RES 9
+#define BUSY_POLLS 3  // isBusy polls of the backend until a page is sent
+
+/*
+ * Backend like a DMA transfer: the bytes are sent when the transfer has finished, BUSY_POLLS calls of isBusy after
+ * startTransfer. Checks that the display is selected for every page and was deselected after the page before.
+ */
+class HostFlushBackend : public DogFlushBackend
+{
+  public:
+    const byte *dat;  // NULL if no transfer is running
+    unsigned int len;
+    unsigned int polls;
+    unsigned int transfers;
+    unsigned long selects;  // CS selections at the last startTransfer
+    unsigned int errors;
+
+    HostFlushBackend (void)
+    {
+      dat = NULL;
+      transfers = 0;
+      selects = 0;
+      errors = 0;
+    }
+
+    void startTransfer (const byte *dat, unsigned int len);
+    bool isBusy (void);
+};
+
+DogEmulator EMU;
+DogGraphicDisplay DOG;
+HostFlushBackend backend;
+byte expected[128 * 8];  // frame sent by the last flush, page by page
+DogCanvas reference(expected, 128, 64);
+unsigned int errors = 0;
+
+/*----------------------------
+Func: startTransfer
+Desc: starts a simulated transfer, the data is read when it has finished
+Vars: data, count of bytes
+------------------------------*/
+void HostFlushBackend::startTransfer(const byte *dat, unsigned int len)
+{
+  unsigned long count = EMU.getStats().selects;
+
+  if(this->dat != NULL || digitalRead(PIN_CS) != LOW || digitalRead(PIN_A0) != HIGH || !SPI.inTransaction())
+  {
+    printf("page %u: transfer started without selected display or while busy\n", transfers);
+    errors++;
+  }
+  if(transfers > 0 && count == selects)  // every page has its own selection, CS went high after the page before
+  {
+    printf("page %u: CS stayed low after the page before\n", transfers);
+    errors++;
+  }
+  selects = count;
+  this->dat = dat;
+  this->len = len;
+  polls = BUSY_POLLS;
+  transfers++;
+}
+
+/*----------------------------
+Func: isBusy
+Desc: returns true for BUSY_POLLS calls, then sends the bytes to the emulator
+Vars: none
+------------------------------*/
+bool HostFlushBackend::isBusy(void)
+{
+  if(dat == NULL) return false;
+  if(polls > 0)
+  {
+    polls--;
+    return true;
+  }
+  for(unsigned int i = 0; i < len; i++) SPI.transfer(dat[i]);  // like DMA, the buffer is not overwritten
+  dat = NULL;
+  return false;
+}
+
+/*----------------------------
+Func: draw_frame
+Desc: draws a frame into the canvas of the display and into the reference canvas
+Vars: canvas or display, frame number
+------------------------------*/
+template <class T> static void draw_frame(T &target, int frame)
+{
+  target.drawRect(4 + frame * 10, 4, 20, 12, true);
+  target.drawCircle(64, 32, 10 + frame * 5, false);
+  target.drawLine(0, 63, 127, frame * 8);
+}
+
+/*----------------------------
+Func: check
+Desc: counts an error if the condition is false
+Vars: condition, text of the error
+------------------------------*/
+static void check(bool condition, const char *text)
+{
+  if(condition) return;
+  printf("failed: %s\n", text);
+  errors++;
+}
+
+/*----------------------------
+Func: check_ram
+Desc: compares the display RAM with the reference canvas and checks that the bus was released
+Vars: name of the step
+------------------------------*/
+static void check_ram(const char *step)
+{
+  unsigned int different = 0;
+
+  for(byte page = 0; page < 8; page++)
+    for(byte column = 0; column < 128; column++)
+      if(EMU.getRam(column, page) != expected[page * 128 + column]) different++;
+  printf("%-16s %4u different bytes, CS %s, %s\n", step, different, digitalRead(PIN_CS) ? "high" : "low",
+         SPI.inTransaction() ? "in transaction" : "no transaction");
+  if(different != 0 || digitalRead(PIN_CS) != HIGH || SPI.inTransaction())
+    errors++;
+}
+
+int main(void)
+{
+  unsigned int polls = 0;
+
+  EMU.begin(PIN_CS, PIN_A0, PIN_RES, DOGM128);
+  DOG.begin(PIN_CS, 0, 0, PIN_A0, PIN_RES, DOGM128);  //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  DOG.createCanvas(128, 64, 0, 0, CANVAS_DOUBLE_BUFFERED);
+  DOG.setFlushBackend(&backend);
+  reference.clear();
+
+  // frame 0 is sent while frame 1 is drawn into the second buffer
+  draw_frame(DOG, 0);
+  draw_frame(reference, 0);
+  DOG.flushCanvasAsync();
+  check(backend.transfers == 1 && DOG.isFlushBusy(), "the first page is sent in the background");
+  draw_frame(DOG, 1);
+  check(DOG.isFlushBusy(), "drawing doesn't wait for the flush");
+  while(DOG.isFlushBusy()) polls++;
+  printf("frame 0: %u pages, %u polls\n", backend.transfers, polls);
+  check(backend.transfers == 8, "all pages of the first frame are sent");
+  check_ram("frame 0");
+
+  // frame 1 only sends its changes, the buffer started with a copy of frame 0
+  draw_frame(reference, 1);
+  backend.transfers = 0;
+  DOG.flushCanvasAsync();
+  DOG.waitFlush();
+  printf("frame 1: %u pages\n", backend.transfers);
+  check_ram("frame 1");
+
+  // without backend the pages are sent before flushCanvasAsync returns
+  DOG.setFlushBackend(NULL);
+  draw_frame(DOG, 2);
+  draw_frame(reference, 2);
+  EMU.resetStats();
+  DOG.flushCanvasAsync();
+  check(!DOG.isFlushBusy(), "no flush is running without backend");
+  check_ram("frame 2 at once");
+
+  DOG.deleteCanvas();
+  errors += backend.errors;
+  if(errors != 0)
+  {
+    printf("%u errors\n", errors);
+    return 1;
+  }
+  printf("passed\n");
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host program: draws text and shapes on an emulated DOGM128-6 and writes the display RAM and the glass as PBM files.
+ * The text is drawn again with the font read from a file, through a DogStreamAsset.
+ * Build and run it from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <DogGraphicDisplay.h>
+#include "DogEmulator.h"
+#include "HostFile.h"
+#include "ubuntumono_b_16.h"
+
+DogEmulator EMU;
+DogGraphicDisplay DOG;
+
+/*----------------------------
+Func: print_stats
+Desc: prints what the controller received since the last call
+Vars: name of the step
+------------------------------*/
+static void print_stats(const char *step)
+{
+  DogEmulatorStats stats = EMU.getStats();
+
+  printf("%-12s bytes %6lu  commands %5lu  data %6lu  selects %4lu  a0 %5lu  errors %lu\n",
+         step, stats.bytes, stats.commands, stats.data, stats.selects, stats.a0Changes, stats.errors);
+  EMU.resetStats();
+}
+
+/*----------------------------
+Func: file_font
+Desc: writes the font into a file and draws the text of the first step again with the font read from the file,
+      returns false if the display RAM changed
+Vars: none
+------------------------------*/
+static bool file_font(void)
+{
+  byte ram[2][128];
+  FILE *out = fopen("dog_font.bin", "wb");
+  HostFile file;
+  bool same = true;
+
+  if(out == NULL) return false;
+  fwrite(UBUNTUMONO_B_16, 1, sizeof(UBUNTUMONO_B_16), out);
+  fclose(out);
+  if(!file.open("dog_font.bin")) return false;
+
+  for(byte page = 0; page < 2; page++)
+    for(byte column = 0; column < 128; column++) ram[page][column] = EMU.getRam(column, page);
+
+  DogStreamAsset<HostFile> font(file, 0, 4 * DOG_ASSET_BLOCK);  // 4 blocks of the file in RAM
+  DOG.string(0, 0, font, "Hello World", ALIGN_CENTER);
+
+  for(byte page = 0; page < 2; page++)
+    for(byte column = 0; column < 128; column++) same = same && ram[page][column] == EMU.getRam(column, page);
+  printf("file font: %lu of %lu bytes read from the file, cache hits %lu misses %lu\n",
+         file.reads(), (unsigned long)sizeof(UBUNTUMONO_B_16), font.hits(), font.misses());
+  return same;
+}
+
+int main(void)
+{
+  EMU.begin(6, 8, 9, DOGM128);  // the emulated panel listens to the pins of the display
+  DOG.begin(6, 0, 0, 8, 9, DOGM128);  //CS = 6, 0,0= use Hardware SPI, A0 = 8, RESET = 9, EA DOGM128-6 (=128x64 dots)
+  print_stats("begin");
+
+  DOG.string(0, 0, UBUNTUMONO_B_16, "Hello World", ALIGN_CENTER);
+  print_stats("string");
+
+  DOG.createCanvas(128, 48, 0, 2, CANVAS_BUFFERED);  // below the text, upper left corner in pages
+  DOG.drawLine(0, 0, 127, 47);
+  DOG.drawCircle(50, 24, 20, false);
+  DOG.drawCircle(20, 20, 10, true);
+  DOG.drawRect(60, 10, 20, 10, true);
+  DOG.drawCross(90, 20, 10, 10);
+  DOG.flushCanvas();
+  DOG.deleteCanvas();
+  print_stats("canvas");
+
+  if(!file_font())
+  {
+    printf("text with the font from the file is different\n");
+    return 1;
+  }
+  print_stats("file font");
+
+  if(!EMU.writeRamPBM("dog_ram.pbm") || !EMU.writeScreenPBM("dog_screen.pbm"))
+  {
+    printf("PBM files can't be written\n");
+    return 1;
+  }
+  printf("written: dog_ram.pbm (132x65 display RAM), dog_screen.pbm (128x64 glass)\n");
+  return 0;
+}
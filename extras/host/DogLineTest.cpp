@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host test of clipped lines: random lines, also with end points far outside, are drawn into a canvas with and without a clip
+ * rectangle. The clipped line has to set exactly the pixels of the unclipped line inside the rectangle, and the unclipped line
+ * the pixels of the Bresenham line inside the canvas. Build and run it from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <DogCanvas.h>
+
+#define WIDTH 128
+#define HEIGHT 64
+#define LINES 20000
+
+byte whole[WIDTH * HEIGHT / 8], clipped[WIDTH * HEIGHT / 8], expected[WIDTH * HEIGHT / 8];
+DogCanvas canvasWhole(whole, WIDTH, HEIGHT);
+DogCanvas canvasClipped(clipped, WIDTH, HEIGHT);
+
+/*----------------------------
+Func: pixel
+Desc: returns a pixel of a canvas buffer
+Vars: buffer, coordinates
+------------------------------*/
+static bool pixel(const byte *buffer, int x, int y)
+{
+  return buffer[(y >> 3) * WIDTH + x] & (1 << (y & 7));
+}
+
+/*----------------------------
+Func: reference_line
+Desc: draws the line of the Bresenham algorithm of drawLine without any clipping, pixels outside the canvas are skipped
+Vars: start and end coordinates
+------------------------------*/
+static void reference_line(int x0, int y0, int x1, int y1)
+{
+  int dx = abs(x1-x0), sx = x0<x1 ? 1 : -1;
+  int dy = abs(y1-y0), sy = y0<y1 ? 1 : -1;
+  int err = (dx>dy ? dx : -dy)/2, e2;
+
+  memset(expected, 0, sizeof(expected));
+  for(;;){
+    if(x0 >= 0 && x0 < WIDTH && y0 >= 0 && y0 < HEIGHT) expected[(y0 >> 3) * WIDTH + x0] |= 1 << (y0 & 7);
+    if (x0==x1 && y0==y1) break;
+    e2 = err;
+    if (e2 >-dx) { err -= dy; x0 += sx; }
+    if (e2 < dy) { err += dx; y0 += sy; }
+  }
+}
+
+int main(void)
+{
+  unsigned int errors = 0;
+  int x0, y0, x1, y1, cx, cy, cw, ch;
+
+  randomSeed(1);
+  for(int line = 0; line < LINES; line++)
+  {
+    int range = (line & 1) ? 40 : 400;  // short lines near the canvas and long lines from far outside
+
+    x0 = random(-range, WIDTH + range);
+    y0 = random(-range, HEIGHT + range);
+    x1 = random(-range, WIDTH + range);
+    y1 = random(-range, HEIGHT + range);
+    cx = random(0, WIDTH);
+    cy = random(0, HEIGHT);
+    cw = random(1, WIDTH - cx + 1);
+    ch = random(1, HEIGHT - cy + 1);
+
+    canvasWhole.clear();
+    canvasWhole.drawLine(x0, y0, x1, y1);
+    canvasClipped.clear();
+    canvasClipped.pushClip(cx, cy, cw, ch);
+    canvasClipped.drawLine(x0, y0, x1, y1);
+    canvasClipped.popClip();
+    reference_line(x0, y0, x1, y1);
+
+    if(memcmp(whole, expected, sizeof(whole)) != 0)
+    {
+      if(errors++ < 10) printf("line %d,%d - %d,%d differs from the Bresenham line\n", x0, y0, x1, y1);
+      continue;
+    }
+    for(int y = 0; y < HEIGHT; y++)
+    {
+      for(int x = 0; x < WIDTH; x++)
+      {
+        bool inside = x >= cx && x < cx + cw && y >= cy && y < cy + ch;
+
+        if(pixel(clipped, x, y) != (inside && pixel(whole, x, y)))
+        {
+          if(errors++ < 10) printf("line %d,%d - %d,%d clipped to %d,%d %dx%d differs at %d,%d\n", x0, y0, x1, y1, cx, cy, cw, ch, x, y);
+          y = HEIGHT;
+          break;
+        }
+      }
+    }
+  }
+
+  if(errors != 0)
+  {
+    printf("%u of %d lines differ\n", errors, LINES);
+    return 1;
+  }
+  printf("%d lines passed\n", LINES);
+  return 0;
+}
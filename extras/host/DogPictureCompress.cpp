@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Host tool: converts a BLH-picture (C array with width, height and the data page by page) into a compressed picture
+ * (0, 'R', width, height, run length encoded data), see DogCanvas.h. Build it from the root of the library, see README.md.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include "DogConvert.h"
+
+int main(int argc, char *argv[])
+{
+  std::vector<unsigned char> picture, data, out;
+  FILE *file;
+  size_t size;
+
+  if(argc < 3)
+  {
+    fprintf(stderr, "usage: %s picture.h NAME > picture_rle.h\n", argv[0]);
+    return 2;
+  }
+  file = fopen(argv[1], "r");
+  if(file == NULL)
+  {
+    fprintf(stderr, "%s can't be read\n", argv[1]);
+    return 2;
+  }
+  if(!read_array(file, picture) || picture.size() < 2)
+  {
+    fprintf(stderr, "no picture array in %s\n", argv[1]);
+    fclose(file);
+    return 1;
+  }
+  fclose(file);
+
+  size = (size_t)picture[0] * ((picture[1] + 7) / 8);  // width * pages
+  if(picture[0] == 0 || picture.size() < size + 2)
+  {
+    fprintf(stderr, "picture of %u x %u needs %u data bytes, %u found\n", picture[0], picture[1], (unsigned)size, (unsigned)picture.size() - 2);
+    return 1;
+  }
+  data.assign(picture.begin() + 2, picture.begin() + 2 + size);
+
+  out.push_back(0);
+  out.push_back('R');  // PICTURE_RLE
+  out.push_back(picture[0]);
+  out.push_back(picture[1]);
+  compress(data, out);
+
+  printf("/* %s: %u x %u pixels, compressed with DogPictureCompress: %u bytes instead of %u */\n",
+         argv[2], picture[0], picture[1], (unsigned)out.size(), (unsigned)size + 2);
+  printf("const byte %s[%u] PROGMEM = {", argv[2], (unsigned)out.size());
+  for(size_t i = 0; i < out.size(); i++)
+    printf("%s0x%02X", i % 16 ? ", " : (i ? ",\n  " : "\n  "), out[i]);
+  printf("\n};\n");
+  return 0;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Stand-in for the Arduino core and the SPI library on a Linux host.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <time.h>
+#include <Arduino.h>
+#include <SPI.h>
+#include "DogEmulator.h"
+
+SPIClass SPI;
+SPIClass SPI1;
+
+static byte pinLevel[HOST_PINS];
+static bool pinInit = false;
+static unsigned long delayOffset = 0;  // delay does not sleep, it moves the clock forward
+
+/*----------------------------
+Func: pin_init
+Desc: all pins start high like inputs with pull-up, so no emulator is selected before the library drives its CS pin
+Vars: none
+------------------------------*/
+static void pin_init(void)
+{
+  if(pinInit) return;
+  memset(pinLevel, HIGH, sizeof(pinLevel));
+  pinInit = true;
+}
+
+/*----------------------------
+Func: pinMode
+Desc: the mode is not emulated, every pin can be written and read
+Vars: pin, mode
+------------------------------*/
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+  pin_init();
+}
+
+/*----------------------------
+Func: digitalWrite
+Desc: sets the level of a pin, a change is handed to the emulators
+Vars: pin, level (HIGH, LOW)
+------------------------------*/
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  byte level = val ? HIGH : LOW;
+
+  pin_init();
+  if(pinLevel[pin] == level) return;
+  pinLevel[pin] = level;
+  DogEmulator::pin_changed(pin, level);
+}
+
+/*----------------------------
+Func: digitalRead
+Desc: returns the level of a pin
+Vars: pin
+------------------------------*/
+int digitalRead(uint8_t pin)
+{
+  pin_init();
+  return pinLevel[pin];
+}
+
+/*----------------------------
+Func: micros
+Desc: returns the microseconds of the monotonic host clock, plus the time waited with delay
+Vars: none
+------------------------------*/
+unsigned long micros(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)now.tv_sec * 1000000UL + now.tv_nsec / 1000 + delayOffset;
+}
+
+/*----------------------------
+Func: millis
+Desc: returns the milliseconds of the host clock, see micros
+Vars: none
+------------------------------*/
+unsigned long millis(void)
+{
+  return micros() / 1000;
+}
+
+/*----------------------------
+Func: delay
+Desc: moves the clock forward without waiting, so programs with long delays run at full speed
+Vars: milliseconds
+------------------------------*/
+void delay(unsigned long ms)
+{
+  delayOffset += ms * 1000;
+}
+
+/*----------------------------
+Func: delayMicroseconds
+Desc: moves the clock forward without waiting
+Vars: microseconds
+------------------------------*/
+void delayMicroseconds(unsigned int us)
+{
+  delayOffset += us;
+}
+
+/*----------------------------
+Func: random
+Desc: returns a random number from 0 to howbig-1
+Vars: upper limit
+------------------------------*/
+long random(long howbig)
+{
+  if(howbig <= 0) return 0;
+  return rand() % howbig;
+}
+
+/*----------------------------
+Func: random
+Desc: returns a random number from howsmall to howbig-1
+Vars: lower and upper limit
+------------------------------*/
+long random(long howsmall, long howbig)
+{
+  if(howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+/*----------------------------
+Func: randomSeed
+Desc: starts the random numbers with a seed
+Vars: seed
+------------------------------*/
+void randomSeed(unsigned long seed)
+{
+  srand(seed);
+}
+
+//----------------------------------------------------Stream----------------------------------------------------
+
+/*----------------------------
+Func: readBytes
+Desc: reads bytes until the length is reached or the stream is empty, there is no timeout on the host
+Vars: buffer, length, returns the count of bytes read
+------------------------------*/
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+  return readBytes((uint8_t *)buffer, length);
+}
+
+/*----------------------------
+Func: readBytes
+Desc: reads bytes until the length is reached or the stream is empty
+Vars: buffer, length, returns the count of bytes read
+------------------------------*/
+size_t Stream::readBytes(uint8_t *buffer, size_t length)
+{
+  size_t count = 0;
+  int c;
+
+  while(count < length && (c = read()) >= 0)
+    buffer[count++] = c;
+  return count;
+}
+
+//----------------------------------------------------SPI----------------------------------------------------
+
+/*-----------------------------
+constructor for the default settings of the Arduino SPI library
+*/
+SPISettings::SPISettings(void)
+{
+  clock = 4000000;
+  bitOrder = MSBFIRST;
+  dataMode = SPI_MODE0;
+}
+
+/*-----------------------------
+constructor for settings
+*/
+SPISettings::SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+{
+  this->clock = clock;
+  this->bitOrder = bitOrder;
+  this->dataMode = dataMode;
+}
+
+/*-----------------------------
+constructor for a SPI port
+*/
+SPIClass::SPIClass(void)
+{
+  started = false;
+  transaction = false;
+}
+
+/*----------------------------
+Func: begin
+Desc: starts the port
+Vars: none
+------------------------------*/
+void SPIClass::begin(void)
+{
+  started = true;
+}
+
+/*----------------------------
+Func: end
+Desc: stops the port
+Vars: none
+------------------------------*/
+void SPIClass::end(void)
+{
+  started = false;
+  transaction = false;
+}
+
+/*----------------------------
+Func: beginTransaction
+Desc: uses the settings until endTransaction
+Vars: settings
+------------------------------*/
+void SPIClass::beginTransaction(SPISettings settings)
+{
+  this->settings = settings;
+  transaction = true;
+}
+
+/*----------------------------
+Func: endTransaction
+Desc: ends the transaction, the port can be used by other devices
+Vars: none
+------------------------------*/
+void SPIClass::endTransaction(void)
+{
+  transaction = false;
+}
+
+/*----------------------------
+Func: transfer
+Desc: sends one byte to the emulators, nothing is read back
+Vars: data
+------------------------------*/
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  DogEmulator::spi_received(this, data);
+  return 0;
+}
+
+/*----------------------------
+Func: transfer
+Desc: sends a buffer to the emulators, the buffer is overwritten with the received bytes (0)
+Vars: buffer, count of bytes
+------------------------------*/
+void SPIClass::transfer(void *buf, size_t count)
+{
+  uint8_t *ptr = (uint8_t *)buf;
+
+  for(size_t i = 0; i < count; i++)
+    ptr[i] = transfer(ptr[i]);
+}
+
+/*----------------------------
+Func: isStarted
+Desc: returns true between begin and end
+Vars: none
+------------------------------*/
+bool SPIClass::isStarted(void)
+{
+  return started;
+}
+
+/*----------------------------
+Func: inTransaction
+Desc: returns true between beginTransaction and endTransaction
+Vars: none
+------------------------------*/
+bool SPIClass::inTransaction(void)
+{
+  return transaction;
+}
+
+/*----------------------------
+Func: getSettings
+Desc: returns the settings of the last transaction
+Vars: none
+------------------------------*/
+SPISettings SPIClass::getSettings(void)
+{
+  return settings;
+}
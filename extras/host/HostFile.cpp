@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * File on the host as Stream with seek.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include "HostFile.h"
+
+/*-----------------------------
+constructor for class, starts without file
+*/
+HostFile::HostFile()
+{
+  file = NULL;
+  readCount = 0;
+}
+
+/*-----------------------------
+destructor, closes the file
+*/
+HostFile::~HostFile()
+{
+  close();
+}
+
+/*----------------------------
+Func: open
+Desc: opens a file for reading, a file opened before is closed
+Vars: path, returns false if the file can't be opened
+------------------------------*/
+bool HostFile::open(const char *path)
+{
+  close();
+  file = fopen(path, "rb");
+  return file != NULL;
+}
+
+/*----------------------------
+Func: close
+Desc: closes the file
+Vars: none
+------------------------------*/
+void HostFile::close(void)
+{
+  if(file != NULL) fclose(file);
+  file = NULL;
+}
+
+/*----------------------------
+Func: seek
+Desc: moves to a position of the file
+Vars: position, returns false if the position is behind the end of the file
+------------------------------*/
+bool HostFile::seek(unsigned long pos)
+{
+  if(file == NULL || pos > size()) return false;
+  return fseek(file, pos, SEEK_SET) == 0;
+}
+
+/*----------------------------
+Func: position
+Desc: returns the position of the next byte
+Vars: none
+------------------------------*/
+unsigned long HostFile::position(void)
+{
+  if(file == NULL) return 0;
+  return ftell(file);
+}
+
+/*----------------------------
+Func: size
+Desc: returns the size of the file in bytes
+Vars: none
+------------------------------*/
+unsigned long HostFile::size(void)
+{
+  long pos, end;
+
+  if(file == NULL) return 0;
+  pos = ftell(file);
+  fseek(file, 0, SEEK_END);
+  end = ftell(file);
+  fseek(file, pos, SEEK_SET);
+  return end;
+}
+
+/*----------------------------
+Func: reads
+Desc: returns the count of bytes read from the file, shows how often a cache had to load data
+Vars: none
+------------------------------*/
+unsigned long HostFile::reads(void)
+{
+  return readCount;
+}
+
+/*----------------------------
+Func: available
+Desc: returns the count of bytes up to the end of the file
+Vars: none
+------------------------------*/
+int HostFile::available(void)
+{
+  return size() - position();
+}
+
+/*----------------------------
+Func: read
+Desc: reads the next byte
+Vars: none, returns -1 at the end of the file
+------------------------------*/
+int HostFile::read(void)
+{
+  int c;
+
+  if(file == NULL) return -1;
+  c = fgetc(file);
+  if(c != EOF) readCount++;
+  return c == EOF ? -1 : c;
+}
+
+/*----------------------------
+Func: peek
+Desc: returns the next byte without reading it
+Vars: none, returns -1 at the end of the file
+------------------------------*/
+int HostFile::peek(void)
+{
+  int c;
+
+  if(file == NULL) return -1;
+  c = fgetc(file);
+  if(c == EOF) return -1;
+  ungetc(c, file);
+  return c;
+}
+
+/*----------------------------
+Func: operator bool
+Desc: true if a file is open, like the File of the SD library
+Vars: none
+------------------------------*/
+HostFile::operator bool(void)
+{
+  return file != NULL;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * File on the host as Stream with seek, like the File of the SD library. Used to test DogStreamAsset on a Linux host.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef HOST_FILE_H
+#define HOST_FILE_H
+
+#include <stdio.h>
+#include <Arduino.h>
+
+class HostFile : public Stream
+{
+  public:
+    HostFile ();
+    ~HostFile ();
+    bool open (const char *path);
+    void close (void);
+    bool seek (unsigned long pos);
+    unsigned long position (void);
+    unsigned long size (void);
+    unsigned long reads (void);
+    int available (void);
+    int read (void);
+    int peek (void);
+    operator bool (void);
+
+  private:
+    FILE *file;  // NULL if no file is open
+    unsigned long readCount;  // bytes read from the file
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Stand-in for the Arduino SPI library, every transferred byte is handed to the emulated controllers (see DogEmulator.h).
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings
+{
+  public:
+    SPISettings (void);
+    SPISettings (uint32_t clock, uint8_t bitOrder, uint8_t dataMode);
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass
+{
+  public:
+    SPIClass (void);
+    void begin (void);
+    void end (void);
+    void beginTransaction (SPISettings settings);
+    void endTransaction (void);
+    uint8_t transfer (uint8_t data);
+    void transfer (void *buf, size_t count);
+    bool isStarted (void);
+    bool inTransaction (void);
+    SPISettings getSettings (void);
+
+  private:
+    bool started;
+    bool transaction;
+    SPISettings settings;  // of the running transaction
+};
+
+extern SPIClass SPI;
+extern SPIClass SPI1;  // second port for displays on their own bus
+
+#endif
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Animation: plays frames that are stored as changes to the previous frame.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include "DogAnimation.h"
+#include "DogGraphicDisplay.h"
+
+#define HEADER_SIZE 8  // position of the first frame
+
+/*----------------------------
+Func: DogAnimation
+Desc: constructor, the current frame is kept in memory provided by the caller
+Vars: animation in program memory, buffer for the frame (frameBytes(anim_adress) bytes)
+------------------------------*/
+DogAnimation::DogAnimation(const byte *anim_adress, byte *frame) : progmem(anim_adress)
+{
+  asset = &progmem;
+  init(frame);
+}
+
+/*----------------------------
+Func: DogAnimation
+Desc: constructor, the current frame is kept in memory provided by the caller
+Vars: animation, buffer for the frame (frameBytes(anim) bytes)
+------------------------------*/
+DogAnimation::DogAnimation(DogAsset &anim, byte *frame) : progmem(NULL)
+{
+  asset = &anim;
+  init(frame);
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: DogAnimation
+Desc: constructor, allocates the memory for the frame on the heap
+Vars: animation in program memory
+------------------------------*/
+DogAnimation::DogAnimation(const byte *anim_adress) : DogAnimation(anim_adress, new byte[frameBytes(anim_adress)])
+{
+  frameOwned = true;
+}
+
+/*----------------------------
+Func: DogAnimation
+Desc: constructor, allocates the memory for the frame on the heap
+Vars: animation
+------------------------------*/
+DogAnimation::DogAnimation(DogAsset &anim) : DogAnimation(anim, new byte[frameBytes(anim)])
+{
+  frameOwned = true;
+}
+#endif
+
+/*-----------------------------
+destructor, frees the memory if it was allocated by the constructor. The last frame stays on the display.
+*/
+DogAnimation::~DogAnimation()
+{
+#if !defined(DOG_NO_HEAP)
+  if(frameOwned)
+    delete[] frame;
+#endif
+}
+
+/*----------------------------
+Func: frameBytes
+Desc: returns the memory needed for the current frame, width * pages
+Vars: animation in program memory
+------------------------------*/
+unsigned int DogAnimation::frameBytes(const byte *anim_adress)
+{
+  DogProgmemAsset anim(anim_adress);
+
+  return frameBytes(anim);
+}
+
+/*----------------------------
+Func: frameBytes
+Desc: returns the memory needed for the current frame, width * pages
+Vars: animation
+------------------------------*/
+unsigned int DogAnimation::frameBytes(DogAsset &anim)
+{
+  return anim.read(2) * ((anim.read(3) + 7) / 8);
+}
+
+/*----------------------------
+Func: start
+Desc: shows the first frame on the display and starts playing, the next frames are shown by update
+Vars: display, column (0..127/131) and page (0..3/7) of the upper left corner
+------------------------------*/
+void DogAnimation::start(DogGraphicDisplay &display, byte column, byte page)
+{
+  this->display = &display;
+  this->column = column;
+  this->page = page;
+  pos = HEADER_SIZE;
+  frameIndex = 0;
+  playing = frames > 0;
+  if(!playing) return;
+
+  key_frame();  // the first frame is always a key frame
+  frameDue = millis() + frameTime;
+}
+
+/*----------------------------
+Func: stop
+Desc: stops playing, the current frame stays on the display
+Vars: none
+------------------------------*/
+void DogAnimation::stop(void)
+{
+  playing = false;
+}
+
+/*----------------------------
+Func: update
+Desc: shows the next frame when its time has come. The time is counted from the last frame, so short delays of the caller
+      don't change the frame rate. If the caller is late by more than a frame, the animation is slowed down, no frame is skipped.
+Vars: none, returns true if a frame was shown
+------------------------------*/
+bool DogAnimation::update(void)
+{
+  unsigned long now = millis();
+
+  if(!playing || (long)(now - frameDue) < 0) return false;
+  if(!nextFrame()) return false;
+  frameDue += frameTime;
+  if((long)(now - frameDue) >= 0) frameDue = now + frameTime;  // too late, start again from now
+  return true;
+}
+
+/*----------------------------
+Func: nextFrame
+Desc: shows the next frame immediately. After the last frame the animation starts again with the first one or stops.
+Vars: none, returns false if the animation is not playing
+------------------------------*/
+bool DogAnimation::nextFrame(void)
+{
+  if(!playing) return false;
+
+  if(frameIndex + 1 >= frames)
+  {
+    if(!loop)
+    {
+      playing = false;
+      return false;
+    }
+    frameIndex = 0;
+    pos = HEADER_SIZE;
+  }
+  else frameIndex++;
+
+  if(asset->read(pos) == ANIMATION_DELTA) delta_frame();
+  else key_frame();
+  return true;
+}
+
+/*----------------------------
+Func: isPlaying
+Desc: returns true until the last frame was shown (without loop) or stop was called
+Vars: none
+------------------------------*/
+bool DogAnimation::isPlaying(void)
+{
+  return playing;
+}
+
+/*----------------------------
+Func: setLoop
+Desc: starts the animation again after the last frame, default true
+Vars: state (true = loop, false = stop after the last frame)
+------------------------------*/
+void DogAnimation::setLoop(bool state)
+{
+  loop = state;
+}
+
+/*----------------------------
+Func: setFrameTime
+Desc: changes the time of a frame, the animation stores a default
+Vars: time in ms
+------------------------------*/
+void DogAnimation::setFrameTime(unsigned int ms)
+{
+  frameTime = ms;
+}
+
+/*----------------------------
+Func: getFrame
+Desc: returns the number of the frame on the display, the first frame is 0
+Vars: none
+------------------------------*/
+unsigned int DogAnimation::getFrame(void)
+{
+  return frameIndex;
+}
+
+/*----------------------------
+Func: frameCount
+Desc: returns the count of frames
+Vars: none
+------------------------------*/
+unsigned int DogAnimation::frameCount(void)
+{
+  return frames;
+}
+
+//----------------------------------------------------private Functions----------------------------------------------------
+
+/*----------------------------
+Func: visible_area
+Desc: returns the part of the frame that is inside the display area
+Vars: references for the width in columns and the count of pages
+------------------------------*/
+void DogAnimation::visible_area(byte &visible_width, byte &visible_pages)
+{
+  visible_width = 0;
+  visible_pages = 0;
+  if(column >= display->display_width() || page >= display->page_cnt()) return;
+  visible_width = (column + width > display->display_width()) ? display->display_width() - column : width;
+  visible_pages = (page + pages > display->page_cnt()) ? display->page_cnt() - page : pages;
+}
+
+/*----------------------------
+Func: init
+Desc: reads the header of the animation, used by the constructors
+Vars: buffer for the frame
+------------------------------*/
+void DogAnimation::init(byte *frame)
+{
+  this->frame = frame;
+  frameOwned = false;
+  width = asset->read(2);
+  pages = (asset->read(3) + 7) / 8;
+  frames = asset->read(4) + (asset->read(5) << 8);
+  frameTime = asset->read(6) + (asset->read(7) << 8);
+  if(asset->read(0) != 'A' || asset->read(1) != 'N') frames = 0;  // not an animation, start does nothing
+  frameIndex = 0;
+  pos = HEADER_SIZE;
+  frameDue = 0;
+  display = NULL;
+  column = 0;
+  page = 0;
+  playing = false;
+  loop = true;
+}
+
+/*----------------------------
+Func: key_frame
+Desc: decodes a key frame into the frame buffer and sends all pages that are inside the display area
+Vars: none
+------------------------------*/
+void DogAnimation::key_frame(void)
+{
+  DogBitmap bitmap;
+  byte visible_width, visible_pages, value;
+  byte *data = frame;
+
+  visible_area(visible_width, visible_pages);
+  DogCanvas::bitmap_start(bitmap, *asset, pos + 1, width, true);
+
+  display->burst_start();
+  for(byte p = 0; p < pages; p++)
+  {
+    if(p < visible_pages)
+    {
+      display->mark_ram_dirty(column, column + visible_width - 1, page + p);
+      display->position(column, page + p);
+    }
+    for(byte c = 0; c < width; c++)
+    {
+      value = DogCanvas::bitmap_next(bitmap);
+      *data++ = value;
+      if(p < visible_pages && c < visible_width) display->burst_data(value);
+    }
+  }
+  display->burst_stop();
+  pos = bitmap.pos;
+}
+
+/*----------------------------
+Func: delta_frame
+Desc: applies the runs of a delta frame to the frame buffer and sends the changed bytes, each run with a new position.
+      All runs are sent in one burst.
+Vars: none
+------------------------------*/
+void DogAnimation::delta_frame(void)
+{
+  byte run_page, run_column, length, visible_width, visible_pages;
+  byte *data;
+  bool positioned;
+
+  visible_area(visible_width, visible_pages);
+  pos++;
+
+  display->burst_start();
+  while((run_page = asset->read(pos++)) != ANIMATION_END)
+  {
+    run_column = asset->read(pos++);
+    length = asset->read(pos++);
+    if(run_page >= pages || run_column + length > width)  // outside the frame, not made by the converter
+    {
+      pos += length;
+      continue;
+    }
+    data = &frame[run_page * width + run_column];
+    positioned = false;
+    for(byte i = 0; i < length; i++)
+    {
+      *data ^= asset->read(pos++);
+      if(run_page < visible_pages && run_column + i < visible_width)
+      {
+        if(!positioned)
+        {
+          display->mark_ram_dirty(column + run_column, column + run_column + length - 1, page + run_page);
+          display->position(column + run_column + i, page + run_page);
+          positioned = true;
+        }
+        display->burst_data(*data);
+      }
+      data++;
+    }
+  }
+  display->burst_stop();
+}
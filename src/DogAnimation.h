@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Animation: plays frames that are stored as changes to the previous frame, only the changed bytes are sent to the display.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGANIMATION_H
+#define DOGANIMATION_H
+
+#include <Arduino.h>
+#include "DogAsset.h"
+
+#define ANIMATION_KEY 'K'  // frame stored whole
+#define ANIMATION_DELTA 'D'  // frame stored as changes to the previous frame
+#define ANIMATION_END 0xFF  // page that ends the runs of a delta frame
+
+/*
+ * Animations: 8 byte header 'A','N', width, height in pixels, frame count (low byte, high byte), time of a frame in ms (low byte,
+ * high byte), the frames follow. A key frame starts with ANIMATION_KEY, the data of all pages follows run length encoded like
+ * a compressed picture. A delta frame starts with ANIMATION_DELTA, runs of changed bytes follow: page, column, length and
+ * length bytes that are XORed with the previous frame. The page ANIMATION_END ends the frame. The first frame is a key frame.
+ * extras/host/DogAnimationCompress.cpp converts BLH pictures into an animation.
+ */
+class DogGraphicDisplay;
+
+/*
+ * The player keeps the current frame in RAM (frameBytes), a delta frame changes it and sends the changed runs with a position
+ * and a data burst each. Call update in loop, it shows the next frame when its time has come.
+ */
+class DogAnimation
+{
+  public:
+    DogAnimation (const byte *anim_adress, byte *frame);
+    DogAnimation (DogAsset &anim, byte *frame);
+#if !defined(DOG_NO_HEAP)
+    DogAnimation (const byte *anim_adress);
+    DogAnimation (DogAsset &anim);
+#endif
+    ~DogAnimation ();
+    static unsigned int frameBytes (const byte *anim_adress);
+    static unsigned int frameBytes (DogAsset &anim);
+    void start (DogGraphicDisplay &display, byte column, byte page);
+    void stop (void);
+    bool update (void);
+    bool nextFrame (void);
+    bool isPlaying (void);
+    void setLoop (bool state);
+    void setFrameTime (unsigned int ms);
+    unsigned int getFrame (void);
+    unsigned int frameCount (void);
+
+  private:
+    DogProgmemAsset progmem;  // animation of the constructors with address
+    DogAsset *asset;
+    byte *frame;  // current frame, page by page
+    bool frameOwned;
+    byte width, pages;
+    unsigned int frames, frameTime;
+    unsigned int frameIndex;  // shown frame
+    unsigned int pos;  // position of the next frame
+    unsigned long frameDue;  // millis of the next frame
+    DogGraphicDisplay *display;  // NULL if not started
+    byte column, page;
+    bool playing, loop;
+
+    void visible_area (byte &visible_width, byte &visible_pages);
+    void init (byte *frame);
+    void key_frame (void);
+    void delta_frame (void);
+};
+
+#endif
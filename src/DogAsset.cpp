@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Assets: sources of fonts and pictures, read directly or through a block cache.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include "DogAsset.h"
+#include "DogGlyphCache.h"
+
+#define TAG_EMPTY 0xFFFF
+
+/*----------------------------
+Func: DogAsset
+Desc: constructor of the derived classes
+Vars: address of the data (NULL if it is not addressable), source (DOG_ASSET_PROGMEM, DOG_ASSET_RAM, DOG_ASSET_CACHED)
+------------------------------*/
+DogAsset::DogAsset(const byte *adress, byte source)
+{
+  this->adress = adress;
+  this->source = source;
+}
+
+/*-----------------------------
+destructor, virtual for the derived classes
+*/
+DogAsset::~DogAsset()
+{
+}
+
+/*----------------------------
+Func: key
+Desc: returns a value that identifies the data in a glyph cache: the address of addressable data, else the address of the asset
+      (DogCachedAsset removes its characters from the glyph caches when it is destroyed)
+Vars: none
+------------------------------*/
+const byte *DogAsset::key(void)
+{
+  if(adress != NULL) return adress;
+  return (const byte *)this;
+}
+
+/*----------------------------
+Func: read_source
+Desc: reads a byte of data that is not addressable, implemented by the derived classes
+Vars: position
+------------------------------*/
+byte DogAsset::read_source(unsigned int pos)
+{
+  (void)pos;
+  return 0;
+}
+
+/*----------------------------
+Func: DogProgmemAsset
+Desc: constructor
+Vars: address of the data in program memory
+------------------------------*/
+DogProgmemAsset::DogProgmemAsset(const byte *adress) : DogAsset(adress, DOG_ASSET_PROGMEM)
+{
+}
+
+/*----------------------------
+Func: DogRamAsset
+Desc: constructor
+Vars: address of the data in RAM
+------------------------------*/
+DogRamAsset::DogRamAsset(const byte *adress) : DogAsset(adress, DOG_ASSET_RAM)
+{
+}
+
+/*----------------------------
+Func: DogCachedAsset
+Desc: constructor, uses memory provided by the caller
+Vars: buffer, size of buffer in bytes (at least DOG_ASSET_BLOCK)
+------------------------------*/
+DogCachedAsset::DogCachedAsset(byte *buffer, unsigned int size) : DogAsset(NULL, DOG_ASSET_CACHED)
+{
+  memory = buffer;
+  memoryOwned = false;
+  blocks = (size / DOG_ASSET_BLOCK > DOG_ASSET_BLOCKS_MAX) ? DOG_ASSET_BLOCKS_MAX : size / DOG_ASSET_BLOCK;
+  clear();
+  resetStats();
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: DogCachedAsset
+Desc: constructor, allocates the memory on the heap
+Vars: size in bytes (at least DOG_ASSET_BLOCK)
+------------------------------*/
+DogCachedAsset::DogCachedAsset(unsigned int size) : DogAsset(NULL, DOG_ASSET_CACHED)
+{
+  blocks = (size / DOG_ASSET_BLOCK > DOG_ASSET_BLOCKS_MAX) ? DOG_ASSET_BLOCKS_MAX : size / DOG_ASSET_BLOCK;
+  memory = new byte[blocks * DOG_ASSET_BLOCK];
+  memoryOwned = true;
+  clear();
+  resetStats();
+}
+#endif
+
+/*-----------------------------
+destructor, frees the memory if it was allocated by the constructor. The characters cached with the address of the asset
+as key are removed, another asset can get the same address.
+*/
+DogCachedAsset::~DogCachedAsset()
+{
+  DogGlyphCache::removeFromAll(key());
+#if !defined(DOG_NO_HEAP)
+  if(memoryOwned)
+    delete[] memory;
+#endif
+}
+
+/*----------------------------
+Func: clear
+Desc: removes all blocks, e.g. after the source was changed
+Vars: none
+------------------------------*/
+void DogCachedAsset::clear(void)
+{
+  for(byte i = 0; i < DOG_ASSET_BLOCKS_MAX; i++)
+  {
+    tags[i] = TAG_EMPTY;
+    uses[i] = 0;
+  }
+  last = 0;
+  useCounter = 0;
+}
+
+/*----------------------------
+Func: hits
+Desc: returns how often a byte was read from a cached block
+Vars: none
+------------------------------*/
+unsigned long DogCachedAsset::hits(void)
+{
+  return hitCount;
+}
+
+/*----------------------------
+Func: misses
+Desc: returns how often a block had to be loaded from the source
+Vars: none
+------------------------------*/
+unsigned long DogCachedAsset::misses(void)
+{
+  return missCount;
+}
+
+/*----------------------------
+Func: resetStats
+Desc: sets hits and misses to 0
+Vars: none
+------------------------------*/
+void DogCachedAsset::resetStats(void)
+{
+  hitCount = 0;
+  missCount = 0;
+}
+
+/*----------------------------
+Func: read_source
+Desc: returns a byte from the cache, a missing block is loaded first. The block of the last read is checked first,
+      because fonts and pictures are mostly read in order. Without memory the bytes are read from the source one by one.
+Vars: position
+------------------------------*/
+byte DogCachedAsset::read_source(unsigned int pos)
+{
+  uint16_t tag = pos / DOG_ASSET_BLOCK;
+  byte value;
+
+  if(blocks == 0)
+  {
+    missCount++;
+    return load(pos, &value, 1) ? value : 0;
+  }
+
+  if(tags[last] != tag)  // the block of the last read is already the most recently used one
+  {
+    for(last = 0; last < blocks && tags[last] != tag; last++);
+    if(last == blocks) last = block_load(tag);
+    else hitCount++;
+    block_use(last);
+  }
+  else hitCount++;
+  return memory[last * DOG_ASSET_BLOCK + pos % DOG_ASSET_BLOCK];
+}
+
+/*----------------------------
+Func: block_load
+Desc: loads a block into the cache, replaces the block that was not used for the longest time. Bytes after the end of the
+      source are 0.
+Vars: position / DOG_ASSET_BLOCK, returns the index of the block
+------------------------------*/
+byte DogCachedAsset::block_load(uint16_t tag)
+{
+  byte oldest = 0, i;
+  unsigned int count;
+  byte *data;
+
+  for(i = 1; i < blocks; i++)
+  {
+    if(uses[i] < uses[oldest]) oldest = i;
+  }
+  for(i = 0; i < blocks; i++)
+  {
+    if(tags[i] == TAG_EMPTY)
+    {
+      oldest = i;
+      break;
+    }
+  }
+
+  data = &memory[oldest * DOG_ASSET_BLOCK];
+  count = load((unsigned int)tag * DOG_ASSET_BLOCK, data, DOG_ASSET_BLOCK);
+  if(count < DOG_ASSET_BLOCK) memset(&data[count], 0, DOG_ASSET_BLOCK - count);
+  tags[oldest] = tag;
+  missCount++;
+  return oldest;
+}
+
+/*----------------------------
+Func: block_use
+Desc: marks a block as the most recently used one. Before the counter overflows the use counters are replaced by their order,
+      so the least recently used block keeps the smallest value.
+Vars: index of the block
+------------------------------*/
+void DogCachedAsset::block_use(byte block)
+{
+  byte order[DOG_ASSET_BLOCKS_MAX];
+  byte i, j;
+
+  if(useCounter == 0xFFFF)
+  {
+    for(i = 0; i < blocks; i++)
+    {
+      order[i] = 1;
+      for(j = 0; j < blocks; j++)
+        if(uses[j] < uses[i]) order[i]++;
+    }
+    for(i = 0; i < blocks; i++) uses[i] = order[i];
+    useCounter = blocks;
+  }
+  uses[block] = ++useCounter;
+}
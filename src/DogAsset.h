@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Assets: sources of fonts and pictures. Data in program memory or RAM is read directly, data on a SD card or in an external
+ * flash is read block by block through a small cache, so it never has to fit into RAM as a whole.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGASSET_H
+#define DOGASSET_H
+
+#include <Arduino.h>
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/pgmspace.h>
+#endif
+
+#define DOG_ASSET_BLOCK 32  // bytes that are loaded at once into the cache of DogCachedAsset
+#define DOG_ASSET_BLOCKS_MAX 8  // blocks of one cache, more memory is not used
+
+// where the data of an asset is read from
+#define DOG_ASSET_PROGMEM 0
+#define DOG_ASSET_RAM 1
+#define DOG_ASSET_CACHED 2
+
+/*
+ * Font or picture in the format of DogCanvas.h (positions 0..65535). Every function that takes the address of a font or picture
+ * also takes an asset, the drawing code reads the bytes it needs while it draws.
+ */
+class DogAsset
+{
+  public:
+    virtual ~DogAsset ();
+    byte read (unsigned int pos);
+    const byte *key (void);
+
+  protected:
+    DogAsset (const byte *adress, byte source);
+    virtual byte read_source (unsigned int pos);
+
+  private:
+    const byte *adress;  // data in program memory or RAM, NULL for other sources
+    byte source;
+};
+
+/*----------------------------
+Func: read
+Desc: returns one byte of the font or picture, inline for the data in program memory and RAM that is read for every pixel
+Vars: position
+------------------------------*/
+inline byte DogAsset::read(unsigned int pos)
+{
+  if(source == DOG_ASSET_PROGMEM)
+  {
+#if defined(ARDUINO_ARCH_AVR)
+    return pgm_read_byte(&adress[pos]);
+#else
+    return adress[pos];
+#endif
+  }
+  if(source == DOG_ASSET_RAM) return adress[pos];
+  return read_source(pos);
+}
+
+/*
+ * Font or picture in program memory (PROGMEM), like the address taken by string, picture, drawString and blit.
+ */
+class DogProgmemAsset : public DogAsset
+{
+  public:
+    DogProgmemAsset (const byte *adress);
+};
+
+/*
+ * Font or picture in RAM, e.g. loaded or generated at run time. Clear a glyph cache after the data of a font was changed.
+ */
+class DogRamAsset : public DogAsset
+{
+  public:
+    DogRamAsset (const byte *adress);
+};
+
+/*
+ * Base class for sources that are not addressable. The data is loaded in blocks of DOG_ASSET_BLOCK bytes into the memory of the
+ * cache (size / DOG_ASSET_BLOCK blocks, at most DOG_ASSET_BLOCKS_MAX), the block that was not used for the longest time is replaced.
+ * Derived classes implement load.
+ */
+class DogCachedAsset : public DogAsset
+{
+  public:
+    DogCachedAsset (byte *buffer, unsigned int size);
+#if !defined(DOG_NO_HEAP)
+    DogCachedAsset (unsigned int size);
+#endif
+    ~DogCachedAsset ();
+    void clear (void);
+    unsigned long hits (void);
+    unsigned long misses (void);
+    void resetStats (void);
+
+  protected:
+    virtual unsigned int load (unsigned int pos, byte *buffer, unsigned int length) = 0;  // returns the count of bytes read
+    byte read_source (unsigned int pos);
+
+  private:
+    byte *memory;
+    bool memoryOwned;
+    byte blocks, last;  // count of blocks, block of the last read
+    uint16_t tags[DOG_ASSET_BLOCKS_MAX];  // position / DOG_ASSET_BLOCK of the cached data, 0xFFFF = empty
+    uint16_t uses[DOG_ASSET_BLOCKS_MAX];  // use counter of the last access, the smallest belongs to the least recently used block
+    uint16_t useCounter;
+    unsigned long hitCount, missCount;
+
+    byte block_load (uint16_t tag);
+    void block_use (byte block);
+};
+
+/*
+ * Font or picture in a Stream that can seek, like the File of the SD or LittleFS library, starting at offset in the stream.
+ * The stream has to stay open while the asset is used.
+ */
+template <class T> class DogStreamAsset : public DogCachedAsset
+{
+  public:
+    DogStreamAsset (T &stream, unsigned long offset, byte *buffer, unsigned int size) : DogCachedAsset(buffer, size), stream(stream), offset(offset) {}
+#if !defined(DOG_NO_HEAP)
+    DogStreamAsset (T &stream, unsigned long offset, unsigned int size) : DogCachedAsset(size), stream(stream), offset(offset) {}
+#endif
+
+  protected:
+    unsigned int load (unsigned int pos, byte *buffer, unsigned int length)
+    {
+      if(!stream.seek(offset + pos)) return 0;
+      return stream.readBytes((char *)buffer, length);
+    }
+
+  private:
+    T &stream;
+    unsigned long offset;
+};
+
+#endif
@@ -0,0 +1,1206 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Canvas: drawing area in RAM, shown by a display as its canvas or as a layer.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include "DogCanvas.h"
+#include "DogGraphicDisplay.h"
+
+//----------------------------------------------------public Functions----------------------------------------------------
+
+/*-----------------------------
+constructor for class, starts without memory. Use begin to set the memory.
+*/
+DogCanvas::DogCanvas()
+{
+  buffer = NULL;
+  bufferOwned = false;
+  display = NULL;
+  glyphCache = NULL;
+#if defined(DOG_STATS)
+  pixels = 0;
+#endif
+  sizeX = 0;
+  sizeY = 0;
+  pages = 0;
+  clipDepth = 0;
+  clip_reset();
+}
+
+/*----------------------------
+Func: DogCanvas
+Desc: constructor, uses memory provided by the caller
+Vars: buffer (bytes(sizeX, sizeY) bytes), canvas size
+------------------------------*/
+DogCanvas::DogCanvas(byte *buffer, byte sizeX, byte sizeY)
+{
+  this->buffer = NULL;
+  bufferOwned = false;
+  display = NULL;
+  glyphCache = NULL;
+#if defined(DOG_STATS)
+  pixels = 0;
+#endif
+  begin(buffer, sizeX, sizeY);
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: DogCanvas
+Desc: constructor, allocates the memory on the heap
+Vars: canvas size
+------------------------------*/
+DogCanvas::DogCanvas(byte sizeX, byte sizeY)
+{
+  buffer = NULL;
+  bufferOwned = false;
+  display = NULL;
+  glyphCache = NULL;
+#if defined(DOG_STATS)
+  pixels = 0;
+#endif
+  begin(sizeX, sizeY);
+}
+#endif
+
+/*-----------------------------
+destructor for class, removes the canvas from the display and frees the memory if it was allocated by begin
+*/
+DogCanvas::~DogCanvas()
+{
+  end();
+}
+
+/*----------------------------
+Func: begin
+Desc: sets the memory of the canvas and clears it, memory allocated before is freed. A layer is removed from its display.
+Vars: buffer (bytes(sizeX, sizeY) bytes), canvas size
+------------------------------*/
+void DogCanvas::begin(byte *buffer, byte sizeX, byte sizeY)
+{
+  end();
+
+  this->sizeX = sizeX;
+  pages = (sizeY + 7) / 8;
+  if(pages * 8 <= 0xFF) sizeY = pages * 8;  // y-direction page aligned
+  this->sizeY = sizeY;
+  this->buffer = buffer;
+
+  clipDepth = 0;
+  clip_reset();
+  if(buffer != NULL) memset(buffer, 0, sizeX * pages);
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: begin
+Desc: allocates the memory of the canvas on the heap and clears it, memory allocated before is freed
+Vars: canvas size
+------------------------------*/
+void DogCanvas::begin(byte sizeX, byte sizeY)
+{
+  end();  // free the old memory before allocating the new one
+  begin(new byte[bytes(sizeX, sizeY)], sizeX, sizeY);
+  bufferOwned = true;
+}
+#endif
+
+/*----------------------------
+Func: end
+Desc: frees the memory if it was allocated by begin, memory of the caller is not freed. A layer is removed from its display.
+Vars: none
+------------------------------*/
+void DogCanvas::end()
+{
+  if(display != NULL) display->removeLayer(*this);
+#if !defined(DOG_NO_HEAP)
+  if(bufferOwned)
+    delete[] buffer;
+#endif
+  buffer = NULL;
+  bufferOwned = false;
+  sizeX = 0;
+  sizeY = 0;
+  pages = 0;
+  clip_reset();
+}
+
+/*----------------------------
+Func: bytes
+Desc: returns the memory needed for a canvas
+Vars: canvas size
+------------------------------*/
+unsigned int DogCanvas::bytes(byte sizeX, byte sizeY)
+{
+  return sizeX * ((sizeY + 7) / 8);
+}
+
+/*----------------------------
+Func: width
+Desc: returns the width of the canvas in pixels
+Vars: none
+------------------------------*/
+byte DogCanvas::width(void)
+{
+  return sizeX;
+}
+
+/*----------------------------
+Func: height
+Desc: returns the height of the canvas in pixels (whole pages)
+Vars: none
+------------------------------*/
+byte DogCanvas::height(void)
+{
+  return sizeY;
+}
+
+/*----------------------------
+Func: getBuffer
+Desc: returns the memory of the canvas, page by page like the display RAM
+Vars: none
+------------------------------*/
+byte *DogCanvas::getBuffer(void)
+{
+  return buffer;
+}
+
+/*----------------------------
+Func: setGlyphCache
+Desc: uses a RAM cache for the characters of drawString, one cache can be used by several canvases and displays
+Vars: pointer to cache (NULL = read characters from the font)
+------------------------------*/
+void DogCanvas::setGlyphCache(DogGlyphCache *cache)
+{
+  glyphCache = cache;
+}
+
+/*----------------------------
+Func: setPixel
+Desc: set single pixel value
+Vars: x, y coordinates, value(true = black, false = white
+------------------------------*/
+void DogCanvas::setPixel(int x, int y, bool value)
+{
+  if(x <= clipX1 && y <= clipY1 && x >= clipX0 && y >= clipY0) // check if pixel is within clip rectangle (and canvas)
+  {
+
+    byte page = y >> 3;
+    y = y & 7;
+    if(value)
+    {
+      buffer[page * sizeX + x] |= (1<<y);
+    }
+    else
+    {
+      buffer[page * sizeX + x] &= ~(1<<y);
+    }
+
+    changed(x, x, page);
+#if defined(DOG_STATS)
+    pixels++;
+#endif
+  }
+}
+
+/*----------------------------
+Func: drawLine
+Desc: draw line on display. The pixels are the same as of the unclipped line: pixel i of the major axis has
+      (i * minor - major / 2 + major - 1) / major steps on the minor axis (the Bresenham error term), so the first pixel
+      inside the clip rectangle is calculated directly and only the pixels inside are drawn
+Vars: start and end coordinates
+------------------------------*/
+void DogCanvas::drawLine(int x0, int y0, int x1, int y1)
+{
+  if(y0 == y1 || x0 == x1)  // horizontal and vertical lines are drawn as spans
+  {
+    fill_area(x0, y0, x1, y1, true);
+    return;
+  }
+
+  unsigned long dx = labs((long)x1 - x0), dy = labs((long)y1 - y0);
+  bool steep = dy >= dx;  // y is the major axis, also for diagonal lines
+  unsigned long major = steep ? dy : dx, minor = steep ? dx : dy, half = major / 2, rest;
+  int a = steep ? y0 : x0, b = steep ? x0 : y0;  // start on the major and minor axis
+  int sa = (steep ? y0 < y1 : x0 < x1) ? 1 : -1, sb = (steep ? x0 < x1 : y0 < y1) ? 1 : -1;
+  long first, last, step_min, step_max;  // pixels of the major axis and steps of the minor axis inside the clip rectangle
+  int start_x, start_y;
+
+  clip_steps(a, sa, steep ? clipY0 : clipX0, steep ? clipY1 : clipX1, first, last);
+  clip_steps(b, sb, steep ? clipX0 : clipY0, steep ? clipX1 : clipY1, step_min, step_max);
+  if(last > (long)major) last = major;
+  if(step_max > (long)minor) step_max = minor;
+  if(first > last || step_min > step_max) return;  // line is completely outside
+
+  if(step_min > 0 && (long)(((step_min - 1) * major + half + minor) / minor) > first)  // first pixel with step_min steps
+    first = ((step_min - 1) * major + half + minor) / minor;
+  if(step_max < (long)minor && (long)((step_max * major + half) / minor) < last)  // last pixel with step_max steps
+    last = (step_max * major + half) / minor;
+  if(first > last) return;
+
+  rest = first * minor + major - 1 - half;
+  a += sa * first;
+  b += sb * (long)(rest / major);
+  rest %= major;
+  start_x = steep ? b : a;
+  start_y = steep ? a : b;
+  for(long i = first; ; i++)
+  {
+    if(steep) plot(b, a);
+    else plot(a, b);
+    if(i == last) break;
+    a += sa;
+    rest += minor;
+    if(rest >= major)
+    {
+      rest -= major;
+      b += sb;
+    }
+  }
+  update_area(start_x, start_y, steep ? b : a, steep ? a : b);
+}
+
+/*----------------------------
+Func: drawArrow
+Desc: draw arrow on display
+Vars: start and end coordinates, the head is at the end coordinates
+------------------------------*/
+void DogCanvas::drawArrow(int x0, int y0, int x1, int y1)
+{
+  drawLine(x0,y0,x1,y1);
+  drawLine(x1-(x1-x0)/6-(y1-y0)/6,y1-(y1-y0)/6+(x1-x0)/6,x1,y1);
+  drawLine(x1-(x1-x0)/6+(y1-y0)/6,y1-(y1-y0)/6-(x1-x0)/6,x1,y1);
+}
+
+/*----------------------------
+Func: drawCircle
+Desc: draw circle on display
+Vars: center coordinates, radius, fill( true = filled, false = not filled )
+------------------------------*/
+void DogCanvas::drawCircle(int x0, int y0, int r, bool fill)
+{
+  int x = r;
+  int y = 0;
+  int err = 0;
+  bool inside = (x0 - r >= clipX0 && x0 + r <= clipX1 && y0 - r >= clipY0 && y0 + r <= clipY1);  // no checks per pixel needed
+
+  while (x >= y)
+  {
+    if(!fill && inside)
+    {
+      plot(x0 + x, y0 + y);
+      plot(x0 + y, y0 + x);
+      plot(x0 - y, y0 + x);
+      plot(x0 - x, y0 + y);
+      plot(x0 - x, y0 - y);
+      plot(x0 - y, y0 - x);
+      plot(x0 + y, y0 - x);
+      plot(x0 + x, y0 - y);
+    }
+    else if(!fill)
+    {
+      plot_clipped(x0 + x, y0 + y);
+      plot_clipped(x0 + y, y0 + x);
+      plot_clipped(x0 - y, y0 + x);
+      plot_clipped(x0 - x, y0 + y);
+      plot_clipped(x0 - x, y0 - y);
+      plot_clipped(x0 - y, y0 - x);
+      plot_clipped(x0 + y, y0 - x);
+      plot_clipped(x0 + x, y0 - y);
+    }
+    else
+    {
+      fill_area(x0 - x, y0 + y, x0 + x, y0 + y, true);
+      fill_area(x0 - y, y0 + x, x0 + y, y0 + x, true);
+      fill_area(x0 - x, y0 - y, x0 + x, y0 - y, true);
+      fill_area(x0 - y, y0 - x, x0 + y, y0 - x, true);
+    }
+
+    if (err <= 0)
+    {
+      y += 1;
+      err += 2*y + 1;
+    }
+
+    if (err > 0)
+    {
+      x -= 1;
+      err -= 2*x + 1;
+    }
+  }
+  if(!fill) update_area(x0 - r, y0 - r, x0 + r, y0 + r);
+}
+
+/*----------------------------
+Func: drawRect
+Desc: draw rectangle on display
+Vars: coordinates of upper left corner, width and height, fill( true = filled, false = not filled )
+------------------------------*/
+void DogCanvas::drawRect(int x0, int y0, int width, int height, bool fill)
+{
+  if(!fill)
+  {
+    drawLine(x0, y0, x0 + width, y0);
+    drawLine(x0, y0 + height, x0 + width, y0 + height);
+    drawLine(x0, y0, x0, y0 + height);
+    drawLine(x0 + width, y0, x0 + width, y0 + height);
+  }
+  else
+  {
+    fill_area(x0, y0, x0 + width, y0 + height, true);
+  }
+}
+
+/*----------------------------
+Func: drawCross
+Desc: draw X on display
+Vars: center coordinates, width and height
+------------------------------*/
+void DogCanvas::drawCross(int x0, int y0, int width, int height)
+{
+  drawLine(x0 - width, y0 - height, x0 + width, y0 + height);
+  drawLine(x0 - width, y0 + height, x0 + width, y0 - height);
+}
+
+/*----------------------------
+Func: drawString
+Desc: draws a string with selected font into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, font address in program memory, stringarray
+------------------------------*/
+void DogCanvas::drawString(int x, int y, const byte *font_adress, const char *str)
+{
+  drawString(x, y, font_adress, str, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: drawString
+Desc: draws a string with selected font into the canvas at any pixel position. The glyph cells are written as whole bytes,
+      shifted across two canvas pages if y is not page aligned. STYLE_FULL and STYLE_FULL_INVERSE also fill the text rows left and right of the string.
+Vars: x, y coordinates of upper left corner, font address in program memory, stringarray, style
+------------------------------*/
+void DogCanvas::drawString(int x, int y, const byte *font_adress, const char *str, byte style)
+{
+  DogProgmemAsset font(font_adress);
+
+  drawString(x, y, font, str, style);
+}
+
+/*----------------------------
+Func: drawString
+Desc: draws a string with a font from an asset into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, font, stringarray
+------------------------------*/
+void DogCanvas::drawString(int x, int y, DogAsset &font, const char *str)
+{
+  drawString(x, y, font, str, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: drawString
+Desc: draws a string with a font from an asset into the canvas at any pixel position, see drawString with font address
+Vars: x, y coordinates of upper left corner, font, stringarray, style
+------------------------------*/
+void DogCanvas::drawString(int x, int y, DogAsset &font, const char *str, byte style)
+{
+  byte rop = ROP_COPY;
+
+  if(buffer == NULL) return;
+
+  if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) rop = ROP_NOT;
+  if(style==STYLE_FULL || style==STYLE_FULL_INVERSE)
+    fill_area(clipX0, y, clipX1, y + textHeight(font) - 1, rop == ROP_NOT);
+
+  text_draw(x, y, font, str, NULL, rop);
+}
+
+/*----------------------------
+Func: textWidth
+Desc: returns the width of a string in pixels, characters that are not in the font are skipped
+Vars: font address in program memory, stringarray
+------------------------------*/
+int DogCanvas::textWidth(const byte *font_adress, const char *str)
+{
+  DogProgmemAsset font(font_adress);
+
+  return text_width(font, str, NULL);
+}
+
+/*----------------------------
+Func: textWidth
+Desc: returns the width of a string in pixels, characters that are not in the font are skipped
+Vars: font, stringarray
+------------------------------*/
+int DogCanvas::textWidth(DogAsset &font, const char *str)
+{
+  return text_width(font, str, NULL);
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height of one line of text in pixels (whole pages, like it is drawn)
+Vars: font address in program memory
+------------------------------*/
+int DogCanvas::textHeight(const byte *font_adress)
+{
+  DogProgmemAsset font(font_adress);
+
+  return textHeight(font);
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height of one line of text in pixels (whole pages, like it is drawn)
+Vars: font
+------------------------------*/
+int DogCanvas::textHeight(DogAsset &font)
+{
+  return font.read(6) * 8;
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height in pixels of a string that is wrapped like in drawTextBox
+Vars: font address in program memory, stringarray, width of the text box
+------------------------------*/
+int DogCanvas::textHeight(const byte *font_adress, const char *str, int width)
+{
+  DogProgmemAsset font(font_adress);
+
+  return textHeight(font, str, width);
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height in pixels of a string that is wrapped like in drawTextBox
+Vars: font, stringarray, width of the text box
+------------------------------*/
+int DogCanvas::textHeight(DogAsset &font, const char *str, int width)
+{
+  int lines = 0, line_width;
+
+  while(*str != 0)
+  {
+    text_line(font, str, width, line_width, str);
+    lines++;
+  }
+  return lines * textHeight(font);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string into a rectangle of the canvas, see drawTextBox with style
+Vars: x, y coordinates of upper left corner, width and height of the box, font address in program memory, stringarray, align
+------------------------------*/
+void DogCanvas::drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align)
+{
+  drawTextBox(x, y, width, height, font_adress, str, align, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string into a rectangle of the canvas. Lines are wrapped after the last word that fits (or inside a word that
+      is longer than the box) and at '\n'. If the text needs more lines than the box has, the last line ends with "...".
+      Nothing is drawn outside the box, STYLE_FULL and STYLE_FULL_INVERSE fill the whole box.
+Vars: x, y coordinates of upper left corner, width and height of the box, font address in program memory, stringarray,
+      align (ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER combined with ALIGN_TOP, ALIGN_MIDDLE or ALIGN_BOTTOM), style
+------------------------------*/
+void DogCanvas::drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align, byte style)
+{
+  DogProgmemAsset font(font_adress);
+
+  drawTextBox(x, y, width, height, font, str, align, style);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string with a font from an asset into a rectangle of the canvas, see drawTextBox with style
+Vars: x, y coordinates of upper left corner, width and height of the box, font, stringarray, align
+------------------------------*/
+void DogCanvas::drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align)
+{
+  drawTextBox(x, y, width, height, font, str, align, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string with a font from an asset into a rectangle of the canvas, see drawTextBox with font address
+Vars: x, y coordinates of upper left corner, width and height of the box, font, stringarray, align, style
+------------------------------*/
+void DogCanvas::drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align, byte style)
+{
+  const char *line, *end;
+  int line_height, line_width, lines, max_lines, column;
+  byte rop = ROP_COPY;
+
+  if(buffer == NULL || !pushClip(x, y, width, height)) return;
+
+  if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) rop = ROP_NOT;
+  if(style==STYLE_FULL || style==STYLE_FULL_INVERSE)
+    fill_area(clipX0, clipY0, clipX1, clipY1, rop == ROP_NOT);
+
+  line_height = textHeight(font);
+  if(line_height <= 0)  //bad or empty font, no line fits
+  {
+    popClip();
+    return;
+  }
+  max_lines = height / line_height;
+
+  if((align & ALIGN_VERTICAL) == ALIGN_MIDDLE || (align & ALIGN_VERTICAL) == ALIGN_BOTTOM)
+  {
+    lines = textHeight(font, str, width) / line_height;  //only needed to move the text down
+    if(lines > max_lines) lines = max_lines;
+    if((align & ALIGN_VERTICAL) == ALIGN_MIDDLE) y += (height - lines * line_height) / 2;
+    else y += height - lines * line_height;
+  }
+
+  for(lines = 0; lines < max_lines && *str != 0; lines++, y += line_height)
+  {
+    line = str;
+    end = text_line(font, line, width, line_width, str);
+    if(lines == max_lines - 1 && *str != 0)  //text does not fit, shorten the last line
+      end = text_ellipsis(font, line, end, width, line_width);
+    if(y + line_height <= clipY0 || y > clipY1) continue;  //line is outside the clip rectangle
+
+    column = x;
+    if((align & ALIGN_HORIZONTAL) == ALIGN_RIGHT) column = x + width - line_width;
+    if((align & ALIGN_HORIZONTAL) == ALIGN_CENTER) column = x + (width - line_width) / 2;
+    column = text_draw(column, y, font, line, end, rop);
+    if(lines == max_lines - 1 && *str != 0)
+      text_draw(column, y, font, "...", NULL, rop);
+  }
+  popClip();
+}
+
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture (see picture, also compressed) into the canvas at any pixel position, also partly outside the canvas
+Vars: x, y coordinates of upper left corner, program memory address of data, raster operation (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogCanvas::blit(int x, int y, const byte *pic_adress, byte rop)
+{
+  DogProgmemAsset pic(pic_adress);
+
+  blit(x, y, pic, rop);
+}
+
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture into the canvas, only the pixels that are set in the mask (a BLH-picture of the same size) are changed
+Vars: coordinates of upper left corner, picture and mask in program memory, rop (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogCanvas::blit(int x, int y, const byte *pic_adress, const byte *mask_adress, byte rop)
+{
+  DogProgmemAsset pic(pic_adress), mask(mask_adress);
+
+  blit(x, y, pic, mask, rop);
+}
+
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture (also compressed) from an asset into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, picture, raster operation (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogCanvas::blit(int x, int y, DogAsset &pic, byte rop)
+{
+  DogBitmap bitmap;
+
+  if(buffer == NULL) return;
+  picture_start(bitmap, pic);
+  blit_data(x, y, bitmap, picture_height(pic), rop, NULL);
+}
+
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture from an asset into the canvas, only the pixels that are set in the mask are changed
+Vars: coordinates of upper left corner, picture and mask (same size), rop (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogCanvas::blit(int x, int y, DogAsset &pic, DogAsset &mask, byte rop)
+{
+  DogBitmap bitmap, shape;
+
+  if(buffer == NULL) return;
+  picture_start(bitmap, pic);
+  picture_start(shape, mask);
+  blit_data(x, y, bitmap, picture_height(pic), rop, &shape);
+}
+
+/*----------------------------
+Func: pushClip
+Desc: limits all drawing on the canvas to a rectangle inside the current clip rectangle, the current one is saved
+Vars: coordinates of upper left corner, width and height, returns false if too many clip rectangles are pushed
+------------------------------*/
+bool DogCanvas::pushClip(int x, int y, int width, int height)
+{
+  if(clipDepth >= CLIP_STACK_DEPTH) return false;
+
+  clipStack[clipDepth][0] = clipX0;
+  clipStack[clipDepth][1] = clipY0;
+  clipStack[clipDepth][2] = clipX1;
+  clipStack[clipDepth][3] = clipY1;
+  clipDepth++;
+
+  if(x > clipX0) clipX0 = x;  // intersection with current clip rectangle, may be empty
+  if(y > clipY0) clipY0 = y;
+  if(x + width - 1 < clipX1) clipX1 = x + width - 1;
+  if(y + height - 1 < clipY1) clipY1 = y + height - 1;
+  return true;
+}
+
+/*----------------------------
+Func: popClip
+Desc: restores the clip rectangle that was active before the last pushClip
+Vars: none
+------------------------------*/
+void DogCanvas::popClip(void)
+{
+  if(clipDepth == 0)
+  {
+    clip_reset();
+    return;
+  }
+  clipDepth--;
+  clipX0 = clipStack[clipDepth][0];
+  clipY0 = clipStack[clipDepth][1];
+  clipX1 = clipStack[clipDepth][2];
+  clipY1 = clipStack[clipDepth][3];
+}
+
+/*----------------------------
+Func: clear
+Desc: sets all pixel of the canvas to 0
+Vars: none
+------------------------------*/
+void DogCanvas::clear(void)
+{
+  if(buffer == NULL) return;
+  memset(buffer, 0, sizeX * pages);
+  for(int page = 0; page < pages; page++)
+    changed(0, sizeX - 1, page);
+}
+
+#if defined(DOG_STATS)
+/*----------------------------
+Func: pixelCount
+Desc: returns the count of pixels written since the last resetPixelCount (setPixel, lines, circles, filled areas, text and pictures)
+Vars: none
+------------------------------*/
+unsigned long DogCanvas::pixelCount(void)
+{
+  return pixels;
+}
+
+/*----------------------------
+Func: resetPixelCount
+Desc: sets the count of written pixels to 0
+Vars: none
+------------------------------*/
+void DogCanvas::resetPixelCount(void)
+{
+  pixels = 0;
+}
+#endif
+
+//----------------------------------------------------private Functions----------------------------------------------------
+
+/*----------------------------
+Func: changed
+Desc: called after a column span of a canvas page was changed, the display that shows the canvas sends or marks it
+Vars: start and end column, page (canvas coordinates)
+------------------------------*/
+void DogCanvas::changed(int start_column, int end_column, int page)
+{
+  if(start_column < 0) start_column = 0;  // stay inside canvas, the display area may be larger
+  if(end_column >= sizeX) end_column = sizeX - 1;
+  if(display != NULL && start_column <= end_column && page >= 0 && page < pages)
+    display->canvas_changed(this, start_column, end_column, page);
+}
+
+/*----------------------------
+Func: clip_reset
+Desc: sets the clip rectangle to the whole canvas
+Vars: none
+------------------------------*/
+void DogCanvas::clip_reset(void)
+{
+  clipX0 = 0;
+  clipY0 = 0;
+  clipX1 = sizeX - 1;
+  clipY1 = sizeY - 1;
+}
+
+/*----------------------------
+Func: clip_steps
+Desc: returns the steps from a start coordinate that are inside the clip range of an axis
+Vars: start coordinate, direction (1, -1), first and last coordinate inside, references for the first (at least 0) and last step
+------------------------------*/
+void DogCanvas::clip_steps(int start, int direction, int low, int high, long &first, long &last)
+{
+  first = (direction > 0) ? (long)low - start : (long)start - high;
+  last = (direction > 0) ? (long)high - start : (long)start - low;
+  if(first < 0) first = 0;
+}
+
+/*----------------------------
+Func: blit_data
+Desc: combines page organized bitmap data with the canvas. Each source page is shifted to the pixel position and merged into
+      one or two canvas pages as whole bytes, masks limit the write to the bitmap height and the clip rectangle.
+      The data is read in its stored order, so compressed data can be decoded on the fly.
+Vars: x, y coordinates of upper left corner, bitmap data, height in pixels, raster operation,
+      shape (bitmap of the same size, only set pixels are changed, NULL = all pixels)
+------------------------------*/
+void DogCanvas::blit_data(int x, int y, DogBitmap &bitmap, byte height, byte rop, DogBitmap *shape)
+{
+  byte width = bitmap.width;
+  byte pages = (height + 7) / 8;
+  byte shift = y & 7;  //same for all pages (arithmetic shift, also for negative y)
+  byte valid, mask_low, mask_high, src, opaque = 0xFF;
+  int page, column, column_start, column_end;
+  int index_low, index_high;
+
+  column_start = (x < clipX0) ? clipX0 - x : 0;  //columns of the bitmap inside the clip rectangle
+  column_end = (x + width - 1 > clipX1) ? clipX1 - x : width - 1;
+  if(column_start > column_end) return;
+
+  for(byte row = 0; row < pages; row++)
+  {
+    page = (y >> 3) + row;
+    valid = 0xFF;
+    if(row == pages - 1 && (height & 7)) valid = 0xFF >> (8 - (height & 7));  //last page of the bitmap is not full
+    mask_low = (valid << shift) & row_mask(page);
+    mask_high = shift ? ((valid >> (8 - shift)) & row_mask(page + 1)) : 0;
+    if(mask_low == 0 && mask_high == 0)
+    {
+      bitmap_skip(bitmap, width);
+      if(shape != NULL) bitmap_skip(*shape, width);
+      continue;
+    }
+
+    index_low = page * sizeX + x;  //only used if the page is inside the canvas (mask not 0)
+    index_high = index_low + sizeX;
+    bitmap_skip(bitmap, column_start);
+    if(shape != NULL) bitmap_skip(*shape, column_start);
+    for(column = column_start; column <= column_end; column++)
+    {
+      src = bitmap_next(bitmap);
+      if(shape != NULL) opaque = bitmap_next(*shape);
+      if(mask_low) buffer[index_low + column] = rop_byte(buffer[index_low + column], src << shift, mask_low & (opaque << shift), rop);
+      if(mask_high) buffer[index_high + column] = rop_byte(buffer[index_high + column], src >> (8 - shift), mask_high & (opaque >> (8 - shift)), rop);
+#if defined(DOG_STATS)
+      pixels += bit_count(mask_low & (opaque << shift)) + (mask_high ? bit_count(mask_high & (opaque >> (8 - shift))) : 0);
+#endif
+    }
+    bitmap_skip(bitmap, width - 1 - column_end);
+    if(shape != NULL) bitmap_skip(*shape, width - 1 - column_end);
+  }
+  update_area(x + column_start, y, x + column_end, y + height - 1);
+}
+
+/*----------------------------
+Func: rop_byte
+Desc: combines a canvas byte with a source byte, only the bits of the mask are changed
+Vars: canvas byte, source byte, mask, raster operation (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+byte DogCanvas::rop_byte(byte dest, byte src, byte mask, byte rop)
+{
+  byte result;
+
+  switch(rop)
+  {
+    case ROP_OR: result = dest | src; break;
+    case ROP_AND: result = dest & src; break;
+    case ROP_XOR: result = dest ^ src; break;
+    case ROP_NOT: result = ~src; break;
+    default: result = src; break;  //ROP_COPY
+  }
+  return (dest & ~mask) | (result & mask);
+}
+
+/*----------------------------
+Func: row_mask
+Desc: returns the rows of a canvas page that are inside the clip rectangle as bit mask
+Vars: page (may be outside of canvas)
+------------------------------*/
+byte DogCanvas::row_mask(int page)
+{
+  int first = clipY0 - page * 8;
+  int last = clipY1 - page * 8;
+
+  if(page < 0 || page >= pages) return 0;
+  if(first < 0) first = 0;
+  if(last > 7) last = 7;
+  if(first > last) return 0;
+  return (0xFF << first) & (0xFF >> (7 - last));
+}
+
+/*----------------------------
+Func: font_glyph
+Desc: looks up a character in a font with fixed width (marker 'F','V') or in a proportional font (marker 'F','P').
+      With a glyph cache the decoded data is read from RAM, a missing character is copied to the cache first.
+Vars: font, character, bitmap that is set to the glyph data, use the glyph cache,
+      returns false if the character is not in the font
+------------------------------*/
+bool DogCanvas::font_glyph(DogAsset &font, char character, DogBitmap &glyph, bool cached)
+{
+  byte start_code = font.read(2);  //get first defined character
+  byte last_code = font.read(3);  //get last defined character
+  byte code = (byte)character;
+  unsigned int table, length;
+  const byte *cache_data;
+  byte *buffer;
+
+  if(code < start_code || code > last_code) return false;
+
+  if(font.read(0) == 'F' && font.read(1) == 'P')
+  {
+    //proportional font: table with width and offset of every glyph after the header, glyph data after the table
+    table = 8 + (unsigned int)(code - start_code) * 3;
+    bitmap_start(glyph, font,
+                 8 + (unsigned int)(last_code - start_code + 1) * 3 + font.read(table + 1) + (font.read(table + 2) << 8),
+                 font.read(table), font.read(7) & FONT_RLE);
+  }
+  else
+  {
+    //bytes for header + (ascii - startcode) * bytes per char)
+    bitmap_start(glyph, font, 8 + (unsigned int)(code - start_code) * font.read(7), font.read(4), false);
+  }
+
+  if(cached && glyphCache != NULL)
+  {
+    cache_data = glyphCache->find(font.key(), code);
+    if(cache_data == NULL)
+    {
+      length = glyph.width * font.read(6);  //width * pages
+      buffer = glyphCache->insert(font.key(), code, length);
+      if(buffer == NULL) return true;  //too large for the cache, read from the font
+      for(table = 0; table < length; table++)
+        buffer[table] = bitmap_next(glyph);
+      cache_data = buffer;
+    }
+    glyph.adress = cache_data;
+    glyph.pos = 0;
+    glyph.rle = false;
+    glyph.ram = true;
+  }
+  return true;
+}
+
+/*----------------------------
+Func: text_width
+Desc: returns the width of a string in pixels, characters that are not in the font are skipped
+Vars: font, stringarray, end of the string (NULL = up to the terminating 0)
+------------------------------*/
+int DogCanvas::text_width(DogAsset &font, const char *str, const char *end)
+{
+  int width = 0;
+  DogBitmap glyph;
+
+  while(*str != 0 && str != end)
+  {
+    if(font_glyph(font, *str++, glyph, false)) width += glyph.width;
+  }
+  return width;
+}
+
+/*----------------------------
+Func: text_draw
+Desc: draws a part of a string into the canvas, characters left or right of the clip rectangle are skipped
+Vars: x, y coordinates of upper left corner, font address in program memory, stringarray, end of the string (NULL = up to
+      the terminating 0), raster operation, returns the column after the last character
+------------------------------*/
+int DogCanvas::text_draw(int x, int y, DogAsset &font, const char *str, const char *end, byte rop)
+{
+  byte height = textHeight(font);
+  DogBitmap glyph;
+
+  while(*str != 0 && str != end && x <= clipX1)
+  {
+    if(font_glyph(font, *str++, glyph, true)) //make sure data is valid
+    {
+      //glyphs are stored like pictures: page by page, each page width bytes
+      blit_data(x, y, glyph, height, rop, NULL);
+      x += glyph.width;
+    }
+  }
+  return x;
+}
+
+/*----------------------------
+Func: text_line
+Desc: finds the end of the next line of a wrapped text. The line ends at '\n', after the last word that fits into the width
+      or inside a word that is longer than the width. Spaces at the end of the line are not part of the line.
+Vars: font, stringarray, width in pixels, returns the width of the line in pixels,
+      returns the beginning of the next line, returns the end of the line
+------------------------------*/
+const char *DogCanvas::text_line(DogAsset &font, const char *str, int width, int &line_width, const char *&next)
+{
+  const char *pos = str, *end = str, *word_end = NULL;
+  int pos_width = 0, end_width = 0, word_width = 0;
+  DogBitmap glyph;
+
+  while(*pos != 0 && *pos != '\n')
+  {
+    if(*pos == ' ' && end != str)  //the line may be broken after the last word
+    {
+      word_end = end;
+      word_width = end_width;
+    }
+    if(font_glyph(font, *pos, glyph, false))
+    {
+      if(pos_width + glyph.width > width && end != str) break;  //line is full, at least one character per line
+      pos_width += glyph.width;
+    }
+    if(*pos++ != ' ')
+    {
+      end = pos;
+      end_width = pos_width;
+    }
+  }
+  if(*pos != 0 && *pos != '\n' && word_end != NULL)  //line is full, break after the last complete word
+  {
+    pos = word_end;
+    end = word_end;
+    end_width = word_width;
+  }
+  while(*pos == ' ') pos++;
+  if(*pos == '\n') pos++;
+
+  next = pos;
+  line_width = end_width;
+  return end;
+}
+
+/*----------------------------
+Func: text_ellipsis
+Desc: shortens a line, so "..." fits behind it
+Vars: font, beginning and end of the line, width in pixels, width of the line (changed),
+      returns the new end of the line
+------------------------------*/
+const char *DogCanvas::text_ellipsis(DogAsset &font, const char *str, const char *end, int width, int &line_width)
+{
+  const char *pos = str, *cut = str;
+  int pos_width = 0;
+  DogBitmap glyph;
+
+  width -= text_width(font, "...", NULL);
+  line_width = 0;
+  while(pos != end)
+  {
+    if(font_glyph(font, *pos, glyph, false))
+    {
+      if(pos_width + glyph.width > width) break;
+      pos_width += glyph.width;
+    }
+    if(*pos++ != ' ')  //no spaces before "..."
+    {
+      cut = pos;
+      line_width = pos_width;
+    }
+  }
+  line_width += text_width(font, "...", NULL);
+  return cut;
+}
+
+/*----------------------------
+Func: bitmap_start
+Desc: prepares reading of bitmap data (picture or glyph)
+Vars: bitmap, font or picture, position of the first data byte, width in pixels, run length encoded
+------------------------------*/
+void DogCanvas::bitmap_start(DogBitmap &bitmap, DogAsset &asset, unsigned int pos, byte width, bool rle)
+{
+  bitmap.asset = &asset;
+  bitmap.pos = pos;
+  bitmap.width = width;
+  bitmap.rle = rle;
+  bitmap.ram = false;
+  bitmap.count = 0;
+}
+
+/*----------------------------
+Func: bitmap_next
+Desc: returns the next byte of bitmap data, decodes run length encoded data:
+      control byte with bit 7 set: the next byte is repeated (bits 0..6) + 1 times, else (bits 0..6) + 1 bytes follow unchanged
+Vars: bitmap
+------------------------------*/
+byte DogCanvas::bitmap_next(DogBitmap &bitmap)
+{
+  byte control;
+
+  if(bitmap.ram) return bitmap.adress[bitmap.pos++];  //glyph cache, not compressed
+  if(!bitmap.rle) return bitmap.asset->read(bitmap.pos++);
+
+  if(bitmap.count == 0)  //start of the next run
+  {
+    control = bitmap.asset->read(bitmap.pos++);
+    bitmap.count = (control & 0x7F) + 1;
+    bitmap.repeat = control & 0x80;
+    if(bitmap.repeat) bitmap.value = bitmap.asset->read(bitmap.pos++);
+  }
+  bitmap.count--;
+  if(bitmap.repeat) return bitmap.value;
+  return bitmap.asset->read(bitmap.pos++);
+}
+
+/*----------------------------
+Func: bitmap_skip
+Desc: skips bytes of bitmap data
+Vars: bitmap, count of bytes
+------------------------------*/
+void DogCanvas::bitmap_skip(DogBitmap &bitmap, unsigned int count)
+{
+  if(!bitmap.rle) bitmap.pos += count;
+  else
+  {
+    while(count--) bitmap_next(bitmap);
+  }
+}
+
+/*----------------------------
+Func: picture_rle
+Desc: returns true if a picture is compressed (header 0, PICTURE_RLE, width, height)
+Vars: picture
+------------------------------*/
+bool DogCanvas::picture_rle(DogAsset &pic)
+{
+  return pic.read(0) == 0 && pic.read(1) == PICTURE_RLE;  // raw pictures are never 0 pixels wide
+}
+
+/*----------------------------
+Func: picture_width
+Desc: returns the width of a raw or compressed picture
+Vars: picture
+------------------------------*/
+byte DogCanvas::picture_width(DogAsset &pic)
+{
+  return pic.read(picture_rle(pic) ? 2 : 0);
+}
+
+/*----------------------------
+Func: picture_height
+Desc: returns the height of a raw or compressed picture in pixels
+Vars: picture
+------------------------------*/
+byte DogCanvas::picture_height(DogAsset &pic)
+{
+  return pic.read(picture_rle(pic) ? 3 : 1);
+}
+
+/*----------------------------
+Func: picture_start
+Desc: prepares reading of the data of a raw or compressed picture
+Vars: bitmap, picture in program memory
+------------------------------*/
+void DogCanvas::picture_start(DogBitmap &bitmap, DogAsset &pic)
+{
+  if(picture_rle(pic)) bitmap_start(bitmap, pic, 4, pic.read(2), true);
+  else bitmap_start(bitmap, pic, 2, pic.read(0), false);
+}
+
+#if defined(DOG_STATS)
+/*----------------------------
+Func: bit_count
+Desc: returns the count of set bits, pixels of a page byte
+Vars: byte
+------------------------------*/
+byte DogCanvas::bit_count(byte value)
+{
+  byte count = 0;
+
+  for( ; value; value &= value - 1) count++;
+  return count;
+}
+#endif
+
+/*----------------------------
+Func: plot
+Desc: sets a pixel of the canvas without any checks and without marking it as changed, see update_area
+Vars: x, y coordinates (inside clip rectangle)
+------------------------------*/
+void DogCanvas::plot(int x, int y)
+{
+  buffer[(y >> 3) * sizeX + x] |= (1 << (y & 7));
+#if defined(DOG_STATS)
+  pixels++;
+#endif
+}
+
+/*----------------------------
+Func: plot_clipped
+Desc: sets a pixel of the canvas if it is inside the clip rectangle, without marking it as changed
+Vars: x, y coordinates
+------------------------------*/
+void DogCanvas::plot_clipped(int x, int y)
+{
+  if(x >= clipX0 && x <= clipX1 && y >= clipY0 && y <= clipY1) plot(x, y);
+}
+
+/*----------------------------
+Func: update_area
+Desc: marks all pages of an area of the canvas as changed after drawing with plot
+Vars: corners of the area (canvas coordinates)
+------------------------------*/
+void DogCanvas::update_area(int x0, int y0, int x1, int y1)
+{
+  int tmp;
+
+  if(x0 > x1) { tmp = x0; x0 = x1; x1 = tmp; }
+  if(y0 > y1) { tmp = y0; y0 = y1; y1 = tmp; }
+  if(y0 < clipY0) y0 = clipY0;
+  if(y1 > clipY1) y1 = clipY1;
+
+  for(int page = y0 >> 3; page <= (y1 >> 3); page++)
+    changed(x0, x1, page);
+}
+
+/*----------------------------
+Func: fill_area
+Desc: sets or clears all pixels of an area of the canvas. Works on whole page bytes with masks for the top and bottom rows,
+      so each byte of the canvas is touched only once
+Vars: corners of the area (inclusive, canvas coordinates), value(true = black, false = white)
+------------------------------*/
+void DogCanvas::fill_area(int x0, int y0, int x1, int y1, bool value)
+{
+  int tmp;
+  byte page, page_end, mask;
+  byte *ptr;
+
+  if(x0 > x1) { tmp = x0; x0 = x1; x1 = tmp; }
+  if(y0 > y1) { tmp = y0; y0 = y1; y1 = tmp; }
+  if(x1 < clipX0 || y1 < clipY0 || x0 > clipX1 || y0 > clipY1) return;  // stay inside clip rectangle
+  if(x0 < clipX0) x0 = clipX0;
+  if(y0 < clipY0) y0 = clipY0;
+  if(x1 > clipX1) x1 = clipX1;
+  if(y1 > clipY1) y1 = clipY1;
+  if(x0 > x1 || y0 > y1) return;  // clip rectangle is empty
+
+  page_end = y1 >> 3;
+  for(page = y0 >> 3; page <= page_end; page++)
+  {
+    mask = 0xFF;
+    if(page == (y0 >> 3)) mask &= 0xFF << (y0 & 7);  // top row inside this page
+    if(page == page_end) mask &= 0xFF >> (7 - (y1 & 7));  // bottom row inside this page
+
+    ptr = &buffer[page * sizeX];
+    if(value)
+    {
+      for(tmp = x0; tmp <= x1; tmp++)
+        ptr[tmp] |= mask;
+    }
+    else
+    {
+      for(tmp = x0; tmp <= x1; tmp++)
+        ptr[tmp] &= ~mask;
+    }
+    changed(x0, x1, page);
+#if defined(DOG_STATS)
+    pixels += (unsigned long)bit_count(mask) * (x1 - x0 + 1);
+#endif
+  }
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Canvas: drawing area in RAM, shown by a display as its canvas or as a layer.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGCANVAS_H
+#define DOGCANVAS_H
+
+#include <Arduino.h>
+#include "DogAsset.h"
+#include "DogGlyphCache.h"
+
+#define ALIGN_LEFT 1
+#define ALIGN_RIGHT 2
+#define ALIGN_CENTER 3
+#define ALIGN_TOP 0x10  // vertical alignment for drawTextBox, combined with the horizontal alignment
+#define ALIGN_MIDDLE 0x20
+#define ALIGN_BOTTOM 0x30
+#define ALIGN_HORIZONTAL 0x0F
+#define ALIGN_VERTICAL 0xF0
+
+#define STYLE_NORMAL 1
+#define STYLE_FULL 2
+#define STYLE_INVERSE 3
+#define STYLE_FULL_INVERSE 4
+
+#define ROP_COPY 1
+#define ROP_OR 2
+#define ROP_AND 3
+#define ROP_XOR 4
+#define ROP_NOT 5
+
+#define FONT_RLE 0x01  // flag in byte 7 of a proportional font: glyph data is run length encoded
+#define PICTURE_RLE 'R'  // byte 1 of a compressed picture, byte 0 is 0
+
+#define CLIP_STACK_DEPTH 4  // count of clip rectangles that can be saved with pushClip
+
+// define DOG_STATS in the build flags to count the written pixels (pixelCount), without it the drawing functions count nothing
+
+/*
+ * Fonts: 8 byte header, byte 2 = first character, 3 = last character, 4 = width, 5 = height in pixels, 6 = pages per character.
+ * Fixed width fonts start with 'F','V', byte 7 = bytes per character, the characters follow page by page, each page width bytes.
+ * Proportional fonts start with 'F','P', byte 4 is the widest character, byte 7 = flags (FONT_RLE). After the header follows a table
+ * with 3 bytes per character: width, offset of the data (low byte, high byte) counted from the end of the table.
+ * The data of each character is stored page by page like in fixed width fonts, with FONT_RLE it is run length encoded.
+ *
+ * Pictures (BLH): byte 0 = width, 1 = height in pixels, the data follows page by page, each page width bytes.
+ * Compressed pictures start with 0, PICTURE_RLE, width, height, the data of all pages is run length encoded like the characters
+ * of FONT_RLE fonts and decoded while it is drawn. extras/host/DogPictureCompress.cpp converts BLH pictures.
+ *
+ * Fonts and pictures are read byte by byte while they are drawn. Instead of the address in program memory every function also
+ * takes a DogAsset, e.g. a DogStreamAsset for a font in a file on a SD card, see DogAsset.h.
+ */
+
+/*
+ * Reader for page organized bitmap data (pictures and font characters), decodes run length encoded data on the fly.
+ */
+struct DogBitmap
+{
+  DogAsset *asset;  // font or picture
+  const byte *adress;  // data of the glyph cache
+  unsigned int pos;  // position of the next byte
+  byte width;  // in pixels
+  bool rle;  // data is run length encoded
+  bool ram;  // data is read from adress (glyph cache)
+  byte count;  // bytes left in the current run
+  bool repeat;  // current run repeats value
+  byte value;
+};
+
+class DogGraphicDisplay;
+
+/*
+ * Page organized drawing area like the display RAM: each byte holds 8 rows of one column, the height is rounded up to whole pages.
+ * All drawing functions are clipped to the canvas (and the clip rectangle). A display sends the changes with flushCanvas,
+ * see DogGraphicDisplay::createCanvas and DogGraphicDisplay::addLayer.
+ */
+class DogCanvas
+{
+  public:
+    DogCanvas ();
+    DogCanvas (byte *buffer, byte sizeX, byte sizeY);
+#if !defined(DOG_NO_HEAP)
+    DogCanvas (byte sizeX, byte sizeY);
+#endif
+    ~DogCanvas ();
+    void begin (byte *buffer, byte sizeX, byte sizeY);
+#if !defined(DOG_NO_HEAP)
+    void begin (byte sizeX, byte sizeY);
+#endif
+    void end ();
+    static unsigned int bytes (byte sizeX, byte sizeY);
+    byte width (void);
+    byte height (void);
+    byte *getBuffer (void);
+    void setGlyphCache (DogGlyphCache *cache);
+    void clear (void);
+    void setPixel (int x, int y, bool value);
+    void drawLine (int x0, int y0, int x1, int y1);
+    void drawArrow (int x0, int y0, int x1, int y1);
+    void drawCircle (int x0, int y0, int r, bool fill);
+    void drawRect (int x0, int y0, int width, int height, bool fill);
+    void drawCross (int x0, int y0, int width, int height);
+    void drawString (int x, int y, const byte *font_adress, const char *str);
+    void drawString (int x, int y, const byte *font_adress, const char *str, byte style);
+    void blit (int x, int y, const byte *pic_adress, byte rop);
+    void blit (int x, int y, const byte *pic_adress, const byte *mask_adress, byte rop);
+    int textWidth (const byte *font_adress, const char *str);
+    int textHeight (const byte *font_adress);
+    int textHeight (const byte *font_adress, const char *str, int width);
+    void drawTextBox (int x, int y, int width, int height, const byte *font_adress, const char *str, byte align);
+    void drawTextBox (int x, int y, int width, int height, const byte *font_adress, const char *str, byte align, byte style);
+    void drawString (int x, int y, DogAsset &font, const char *str);
+    void drawString (int x, int y, DogAsset &font, const char *str, byte style);
+    void blit (int x, int y, DogAsset &pic, byte rop);
+    void blit (int x, int y, DogAsset &pic, DogAsset &mask, byte rop);
+    int textWidth (DogAsset &font, const char *str);
+    int textHeight (DogAsset &font);
+    int textHeight (DogAsset &font, const char *str, int width);
+    void drawTextBox (int x, int y, int width, int height, DogAsset &font, const char *str, byte align);
+    void drawTextBox (int x, int y, int width, int height, DogAsset &font, const char *str, byte align, byte style);
+    bool pushClip (int x, int y, int width, int height);
+    void popClip (void);
+#if defined(DOG_STATS)
+    unsigned long pixelCount (void);
+    void resetPixelCount (void);
+#endif
+
+  private:
+    friend class DogGraphicDisplay;
+    friend class DogSprite;
+    friend class DogAnimation;
+
+    byte *buffer;  // NULL without memory
+    bool bufferOwned;  // memory was allocated by begin
+    byte sizeX, sizeY, pages;
+    DogGraphicDisplay *display;  // display that shows the canvas, gets all changes
+    DogGlyphCache *glyphCache;  // NULL if characters are always read from the font
+
+    int clipX0, clipY0, clipX1, clipY1;  // clip rectangle, inclusive, empty if start > end
+    int clipStack[CLIP_STACK_DEPTH][4];
+    byte clipDepth;
+#if defined(DOG_STATS)
+    unsigned long pixels;  // written pixels, see pixelCount
+#endif
+
+    void changed (int start_column, int end_column, int page);
+    void clip_reset (void);
+    void clip_steps (int start, int direction, int low, int high, long &first, long &last);
+    void blit_data (int x, int y, DogBitmap &bitmap, byte height, byte rop, DogBitmap *shape);
+    static byte rop_byte (byte dest, byte src, byte mask, byte rop);
+    byte row_mask (int page);
+    bool font_glyph (DogAsset &font, char character, DogBitmap &glyph, bool cached);
+    int text_width (DogAsset &font, const char *str, const char *end);
+    int text_draw (int x, int y, DogAsset &font, const char *str, const char *end, byte rop);
+    const char *text_line (DogAsset &font, const char *str, int width, int &line_width, const char *&next);
+    const char *text_ellipsis (DogAsset &font, const char *str, const char *end, int width, int &line_width);
+    static void bitmap_start (DogBitmap &bitmap, DogAsset &asset, unsigned int pos, byte width, bool rle);
+    static byte bitmap_next (DogBitmap &bitmap);
+    static void bitmap_skip (DogBitmap &bitmap, unsigned int count);
+    static bool picture_rle (DogAsset &pic);
+    static byte picture_width (DogAsset &pic);
+    static byte picture_height (DogAsset &pic);
+    static void picture_start (DogBitmap &bitmap, DogAsset &pic);
+    void plot (int x, int y);
+    void plot_clipped (int x, int y);
+    void update_area (int x0, int y0, int x1, int y1);
+    void fill_area (int x0, int y0, int x1, int y1, bool value);
+#if defined(DOG_STATS)
+    static byte bit_count (byte value);
+#endif
+};
+
+#endif
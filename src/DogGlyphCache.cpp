@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * RAM cache for font characters, so often used characters are not read from program memory (and decoded) again.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include "DogGlyphCache.h"
+
+// layout of a cache entry, the data of the character follows the header
+#define ENTRY_CHARACTER 0
+#define ENTRY_LENGTH 1
+#define ENTRY_USE 3
+#define ENTRY_FONT 5
+
+DogGlyphCache *DogGlyphCache::first = NULL;
+
+/*----------------------------
+Func: DogGlyphCache
+Desc: constructor, uses memory provided by the caller
+Vars: buffer, size of buffer in bytes
+------------------------------*/
+DogGlyphCache::DogGlyphCache(byte *buffer, unsigned int size)
+{
+  memory = buffer;
+  memoryOwned = false;
+  memorySize = size;
+  clear();
+  resetStats();
+  list_add();
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: DogGlyphCache
+Desc: constructor, allocates the memory on the heap
+Vars: size in bytes
+------------------------------*/
+DogGlyphCache::DogGlyphCache(unsigned int size)
+{
+  memory = new byte[size];
+  memoryOwned = true;
+  memorySize = size;
+  clear();
+  resetStats();
+  list_add();
+}
+#endif
+
+/*-----------------------------
+destructor, frees the memory if it was allocated by the constructor and removes the cache from the list of all caches
+*/
+DogGlyphCache::~DogGlyphCache()
+{
+  DogGlyphCache **link;
+
+  for(link = &first; *link != NULL; link = &(*link)->next)  //remove from the list of all caches
+  {
+    if(*link == this)
+    {
+      *link = next;
+      break;
+    }
+  }
+#if !defined(DOG_NO_HEAP)
+  if(memoryOwned)
+    delete[] memory;
+#endif
+}
+
+/*----------------------------
+Func: clear
+Desc: removes all characters, e.g. after a font in RAM was changed
+Vars: none
+------------------------------*/
+void DogGlyphCache::clear(void)
+{
+  memoryUsed = 0;
+  useCounter = 0;
+}
+
+/*----------------------------
+Func: hits
+Desc: returns how often a character was found in the cache
+Vars: none
+------------------------------*/
+unsigned long DogGlyphCache::hits(void)
+{
+  return hitCount;
+}
+
+/*----------------------------
+Func: misses
+Desc: returns how often a character had to be read from the font
+Vars: none
+------------------------------*/
+unsigned long DogGlyphCache::misses(void)
+{
+  return missCount;
+}
+
+/*----------------------------
+Func: resetStats
+Desc: sets hits and misses to 0
+Vars: none
+------------------------------*/
+void DogGlyphCache::resetStats(void)
+{
+  hitCount = 0;
+  missCount = 0;
+}
+
+/*----------------------------
+Func: size
+Desc: returns the size of the cache in bytes
+Vars: none
+------------------------------*/
+unsigned int DogGlyphCache::size(void)
+{
+  return memorySize;
+}
+
+/*----------------------------
+Func: used
+Desc: returns the bytes used by cached characters (including DOG_GLYPH_HEADER per character)
+Vars: none
+------------------------------*/
+unsigned int DogGlyphCache::used(void)
+{
+  return memoryUsed;
+}
+
+/*----------------------------
+Func: find
+Desc: searches a character and marks it as used
+Vars: font address, character, returns the data of the character or NULL if it is not cached
+------------------------------*/
+const byte *DogGlyphCache::find(const byte *font_adress, byte character)
+{
+  const byte *font;
+  unsigned int pos = 0;
+
+  while(pos < memoryUsed)
+  {
+    if(memory[pos + ENTRY_CHARACTER] == character)  //compare the font address only if the character matches
+    {
+      memcpy(&font, &memory[pos + ENTRY_FONT], sizeof(font));  //header is not aligned
+      if(font == font_adress)
+      {
+        hitCount++;
+        set_use(&memory[pos]);
+        return &memory[pos + DOG_GLYPH_HEADER];
+      }
+    }
+    pos += entry_length(&memory[pos]);
+  }
+  missCount++;
+  return NULL;
+}
+
+/*----------------------------
+Func: insert
+Desc: reserves memory for a character, removes the characters that were not used for the longest time if the cache is full.
+      The caller has to fill in the data before the next call of insert.
+Vars: font address, character, length of data in bytes, returns memory for the data or NULL if the character is larger than the cache
+------------------------------*/
+byte *DogGlyphCache::insert(const byte *font_adress, byte character, unsigned int length)
+{
+  byte *entry;
+
+  if(memory == NULL || length > memorySize || memorySize - length < DOG_GLYPH_HEADER) return NULL;
+  length += DOG_GLYPH_HEADER;
+
+  while(memorySize - memoryUsed < length)
+    remove_oldest();
+
+  entry = &memory[memoryUsed];
+  memoryUsed += length;
+  entry[ENTRY_CHARACTER] = character;
+  entry[ENTRY_LENGTH] = length & 0xFF;
+  entry[ENTRY_LENGTH + 1] = length >> 8;
+  memcpy(&entry[ENTRY_FONT], &font_adress, sizeof(font_adress));
+  set_use(entry);
+  return entry + DOG_GLYPH_HEADER;
+}
+
+/*----------------------------
+Func: remove
+Desc: removes all characters of a font, e.g. after the font in RAM was changed
+Vars: font address (DogAsset::key)
+------------------------------*/
+void DogGlyphCache::remove(const byte *font_adress)
+{
+  const byte *font;
+  unsigned int pos = 0;
+
+  while(pos < memoryUsed)
+  {
+    memcpy(&font, &memory[pos + ENTRY_FONT], sizeof(font));  //header is not aligned
+    if(font == font_adress) remove_entry(pos);  //the next entry moves to pos
+    else pos += entry_length(&memory[pos]);
+  }
+}
+
+/*----------------------------
+Func: removeFromAll
+Desc: removes all characters of a font from every cache, used when an asset that is not addressable is destroyed:
+      the key of the next asset at the same address must not find its characters
+Vars: font address (DogAsset::key)
+------------------------------*/
+void DogGlyphCache::removeFromAll(const byte *font_adress)
+{
+  for(DogGlyphCache *cache = first; cache != NULL; cache = cache->next)
+    cache->remove(font_adress);
+}
+
+/*----------------------------
+Func: set_use
+Desc: marks an entry as used now. When the counter overflows all entries start with the same age again.
+Vars: entry
+------------------------------*/
+void DogGlyphCache::set_use(byte *entry)
+{
+  unsigned int pos;
+
+  if(++useCounter == 0)
+  {
+    for(pos = 0; pos < memoryUsed; pos += entry_length(&memory[pos]))
+    {
+      memory[pos + ENTRY_USE] = 0;
+      memory[pos + ENTRY_USE + 1] = 0;
+    }
+    useCounter = 1;
+  }
+  entry[ENTRY_USE] = useCounter & 0xFF;
+  entry[ENTRY_USE + 1] = useCounter >> 8;
+}
+
+/*----------------------------
+Func: remove_oldest
+Desc: removes the entry that was not used for the longest time, the following entries are moved down
+Vars: none
+------------------------------*/
+void DogGlyphCache::remove_oldest(void)
+{
+  unsigned int pos, oldest = 0, oldest_use = 0xFFFF, use;
+
+  for(pos = 0; pos < memoryUsed; pos += entry_length(&memory[pos]))
+  {
+    use = memory[pos + ENTRY_USE] | ((unsigned int)memory[pos + ENTRY_USE + 1] << 8);
+    if(use <= oldest_use)
+    {
+      oldest = pos;
+      oldest_use = use;
+    }
+  }
+  remove_entry(oldest);
+}
+
+/*----------------------------
+Func: remove_entry
+Desc: removes an entry, the following entries are moved down
+Vars: position of the entry
+------------------------------*/
+void DogGlyphCache::remove_entry(unsigned int pos)
+{
+  unsigned int length = entry_length(&memory[pos]);
+
+  memmove(&memory[pos], &memory[pos + length], memoryUsed - pos - length);
+  memoryUsed -= length;
+}
+
+/*----------------------------
+Func: list_add
+Desc: adds the cache to the list of all caches, used by the constructors
+Vars: none
+------------------------------*/
+void DogGlyphCache::list_add(void)
+{
+  next = first;
+  first = this;
+}
+
+/*----------------------------
+Func: entry_length
+Desc: returns the length of an entry including the header
+Vars: entry
+------------------------------*/
+unsigned int DogGlyphCache::entry_length(const byte *entry)
+{
+  return entry[ENTRY_LENGTH] | ((unsigned int)entry[ENTRY_LENGTH + 1] << 8);
+}
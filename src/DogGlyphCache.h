@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * RAM cache for font characters, so often used characters are not read from program memory (and decoded) again.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGGLYPHCACHE_H
+#define DOGGLYPHCACHE_H
+
+#include <Arduino.h>
+
+/*
+ * Every cached character takes its data (width * pages bytes) plus DOG_GLYPH_HEADER bytes.
+ * If the memory is full, the character that was not used for the longest time is removed.
+ */
+#define DOG_GLYPH_HEADER (sizeof(const byte *) + 5)  // character, length (2 bytes), last use (2 bytes), font address
+
+class DogGlyphCache
+{
+  public:
+    DogGlyphCache (byte *buffer, unsigned int size);
+#if !defined(DOG_NO_HEAP)
+    DogGlyphCache (unsigned int size);
+#endif
+    ~DogGlyphCache ();
+    void clear (void);
+    unsigned long hits (void);
+    unsigned long misses (void);
+    void resetStats (void);
+    unsigned int size (void);
+    unsigned int used (void);
+    const byte *find (const byte *font_adress, byte character);
+    byte *insert (const byte *font_adress, byte character, unsigned int length);
+    void remove (const byte *font_adress);
+    static void removeFromAll (const byte *font_adress);
+
+  private:
+    byte *memory;
+    bool memoryOwned;
+    unsigned int memorySize, memoryUsed;
+    uint16_t useCounter;  // stored with 2 bytes in every entry
+    unsigned long hitCount, missCount;
+    DogGlyphCache *next;  // list of all caches, see removeFromAll
+
+    static DogGlyphCache *first;
+
+    void set_use (byte *entry);
+    void remove_oldest (void);
+    void remove_entry (unsigned int pos);
+    void list_add (void);
+    static unsigned int entry_length (const byte *entry);
+};
+
+#endif
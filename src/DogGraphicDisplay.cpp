@@ -20,6 +20,33 @@
 
 #include "DogGraphicDisplay.h"
 
+#if defined(DOG_FAST_PINS)
+#if defined(ARDUINO_ARCH_AVR)
+// read-modify-write of the port, only between DOG_PINS_LOCK and DOG_PINS_UNLOCK: an interrupt that changes another pin
+// of the same port in between would be undone, digitalWrite also disables the interrupts
+#define DOG_PIN_LOW(port, mask) (*(port) &= ~(mask))
+#define DOG_PIN_HIGH(port, mask) (*(port) |= (mask))
+#define DOG_PINS_LOCK() uint8_t dog_sreg = SREG; cli()
+#define DOG_PINS_UNLOCK() SREG = dog_sreg
+#else
+// OUTCLR and OUTSET follow the OUT register of the port group, writing them only changes the pins of the mask
+#define DOG_PIN_LOW(port, mask) ((port)[(PORT_OUTCLR_OFFSET - PORT_OUT_OFFSET) / 4] = (mask))
+#define DOG_PIN_HIGH(port, mask) ((port)[(PORT_OUTSET_OFFSET - PORT_OUT_OFFSET) / 4] = (mask))
+#define DOG_PINS_LOCK()
+#define DOG_PINS_UNLOCK()
+#endif
+
+// one bit of bit bang SPI with direct register access, data is taken over with the rising edge of CLK
+#define DOG_FAST_BIT(bit) \
+  do \
+  { \
+    if(dat & (bit)) DOG_PIN_HIGH(port_si, mask_si); \
+    else DOG_PIN_LOW(port_si, mask_si); \
+    DOG_PIN_LOW(port_clk, mask_clk); \
+    DOG_PIN_HIGH(port_clk, mask_clk); \
+  }while(0)
+#endif
+
 #define INITLEN 14
 byte init_DOGM128[INITLEN] = {0x40, 0xA1, 0xC0, 0xA6, 0xA2, 0x2F, 0xF8, 0x00, 0x27, 0x81, 0x16, 0xAC, 0x00, 0xAF};
 byte init_DOGL128[INITLEN] = {0x40, 0xA1, 0xC0, 0xA6, 0xA2, 0x2F, 0xF8, 0x00, 0x27, 0x81, 0x10, 0xAC, 0x00, 0xAF};
@@ -31,10 +58,40 @@ byte init_DOGS102[INITLEN_DOGS102] = {0x40, 0xA1, 0xC0, 0xA4, 0xA6, 0xA2, 0x2F,
 //Please use these functions in your sketch
 
 /*-----------------------------
-constructor for class, not needed by Arduino but for complete class. does not do anything.
+constructor for class, not needed by Arduino but for complete class. starts without canvas.
 */
 DogGraphicDisplay::DogGraphicDisplay()
 {
+  type = DOGM128;
+  columnTotal = 128;
+  pageTotal = 8;
+  columnOffset = 0;
+  drawMode = CANVAS_BUFFERED;
+  canvasUpperLeftX = 0;
+  canvasUpperLeftY = 0;
+  canvasFront = NULL;
+  canvasOwned = false;
+  shadow = NULL;
+  shadowOwned = false;
+  flushBackend = NULL;
+  flushActive = false;
+  spiSettings = SPISettings(DOG_SPI_CLOCK, MSBFIRST, SPI_MODE3);
+  bus = NULL;
+  mirror = NULL;
+  mirrorOf = NULL;
+  burstHeld = false;
+  layerCount = 0;
+  areaX0 = 0;  // no canvas and no layers
+  areaX1 = -1;
+  areaPage0 = 0;
+  areaPage1 = -1;
+  scrollLine = 0;
+  scrollY0 = 0;
+  scrollY1 = -1;
+  clear_dirty();
+#if defined(DOG_STATS)
+  resetStats();
+#endif
 }
 
 /*-----------------------------
@@ -60,7 +117,6 @@ Vars: Spi-Port, CS-Pin, A0-Pin (high=data, low=command), p_res = Reset-Pin, type
 ------------------------------*/
 void DogGraphicDisplay::begin(SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type)
 {
-  byte *ptr_init; //pointer to the correct init values
   top_view = false; //default = bottom view
 
 //  DogGraphicDisplay::spi_port = port;
@@ -75,30 +131,74 @@ void DogGraphicDisplay::begin(SPIClass *port, byte p_cs, byte p_a0, byte p_res,
   digitalWrite(p_res, HIGH);
   delay(1);
 
-  //Init DOGM displays, depending on users choice
-  ptr_init = init_DOGM128; //default pointer for wrong parameters
-  if(type == DOGM128) ptr_init = init_DOGM128;
-  else if(type == DOGL128) ptr_init = init_DOGL128;
-  else if(type == DOGM132) ptr_init = init_DOGM132;
-  else if(type == DOGS102) ptr_init = init_DOGS102;
+  panel_setup(type);  //Init DOGM displays, depending on users choice
 
-  DogGraphicDisplay::type = type;
+  clear();
+}
 
-  digitalWrite(p_a0, LOW);  //init display
-  if(type == DOGS102) spi_put(ptr_init, INITLEN_DOGS102);  // shorter init for DOGS102
-  else spi_put(ptr_init, INITLEN);
+/*----------------------------
+Func: Arduino begin function with a shared SPI bus
+Desc: Initializes the DOG Display on a bus that is shared with other displays, the SPI port is started by the bus
+Vars: bus, CS-Pin, A0-Pin (high=data, low=command), p_res = Reset-Pin, type (1=EA DOGM128-6, 2=EA DOGL128-6)
+------------------------------*/
+void DogGraphicDisplay::begin(DogSpiBus &bus, byte p_cs, byte p_a0, byte p_res, byte type)
+{
+  this->bus = &bus;
+  bus.begin();  // only the first display starts the port
+  begin(bus.getPort(), p_cs, p_a0, p_res, type);
+}
 
-  clear();
+/*----------------------------
+Func: Arduino begin function with SPI settings
+Desc: like begin without settings, hardware SPI uses the settings for the transaction of every transfer. Bit bang SPI ignores them.
+Vars: CS-Pin, MOSI-Pin, SCK-Pin (MOSI=SCK Hardware else Software), A0-Pin, Reset-Pin, type,
+      SPI settings (clock up to the limit of the wiring, the panels need MSBFIRST and SPI_MODE0 or SPI_MODE3)
+------------------------------*/
+void DogGraphicDisplay::begin(byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type, SPISettings settings)
+{
+  spiSettings = settings;
+  begin(p_cs, p_si, p_clk, p_a0, p_res, type);
+}
+
+/*----------------------------
+Func: Arduino begin function with Hardware SPI and SPI settings
+Desc: like begin without settings, the settings are used for the transaction of every transfer
+Vars: Spi-Port, CS-Pin, A0-Pin, Reset-Pin, type, SPI settings
+------------------------------*/
+void DogGraphicDisplay::begin(SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type, SPISettings settings)
+{
+  spiSettings = settings;
+  begin(port, p_cs, p_a0, p_res, type);
+}
+
+/*----------------------------
+Func: Arduino begin function with a shared SPI bus and SPI settings
+Desc: like begin without settings, every display on the bus can use its own settings
+Vars: bus, CS-Pin, A0-Pin, Reset-Pin, type, SPI settings
+------------------------------*/
+void DogGraphicDisplay::begin(DogSpiBus &bus, byte p_cs, byte p_a0, byte p_res, byte type, SPISettings settings)
+{
+  spiSettings = settings;
+  begin(bus, p_cs, p_a0, p_res, type);
 }
 
 /*-----------------------------
-Arduino end function. stop SPI if enabled and delete canvas memory area
+Arduino end function. stop SPI if enabled, delete canvas memory area and remove all layers
 */
 void DogGraphicDisplay::end()
 {
-  if(hardware)
+  if(bus != NULL)
+  {
+    waitFlush();
+    bus->remove(this);  // the bus keeps the port running for the other displays
+    bus = NULL;
+  }
+  else if(hardware)
     SPI.end();
-  delete [] canvas;
+  deleteCanvas();
+  while(layerCount > 0)
+    removeLayer(*layers[layerCount - 1].canvas);
+  enableShadow((byte *)NULL);
 }
 
 /*----------------------------
@@ -108,7 +208,6 @@ Vars: CS-Pin, MOSI-Pin, SCK-Pin (MOSI=SCK Hardware else Software), A0-Pin (high=
 ------------------------------*/
 void DogGraphicDisplay::initialize(byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type)
 {
-  byte *ptr_init; //pointer to the correct init values
   top_view = false; //default = bottom view
 
   DogGraphicDisplay::p_a0 = p_a0;
@@ -122,18 +221,7 @@ void DogGraphicDisplay::initialize(byte p_cs, byte p_si, byte p_clk, byte p_a0,
   digitalWrite(p_res, HIGH);
   delay(1);
 
-  //Init DOGM displays, depending on users choice
-  ptr_init = init_DOGM128; //default pointer for wrong parameters
-  if(type == DOGM128) ptr_init = init_DOGM128;
-  else if(type == DOGL128) ptr_init = init_DOGL128;
-  else if(type == DOGM132) ptr_init = init_DOGM132;
-  else if(type == DOGS102) ptr_init = init_DOGS102;
-
-  DogGraphicDisplay::type = type;
-
-  digitalWrite(p_a0, LOW);  //init display
-  if(type == DOGS102) spi_put(ptr_init, INITLEN_DOGS102);  // shorter init for DOGS102
-  else spi_put(ptr_init, INITLEN);
+  panel_setup(type);  //Init DOGM displays, depending on users choice
 
   clear();
 }
@@ -146,24 +234,19 @@ Vars: ---
 void DogGraphicDisplay::clear(void)
 {
   byte page, column;
-  byte page_cnt = 8;
+  byte pages = scrollLine ? DOG_MAX_PAGES : page_cnt();  //scrolled DOGM132 shows RAM pages below the display
 
-  if(type == DOGM132)
-  {
-    page_cnt = 4;
-  }
-
-  for(page = 0; page < page_cnt; page++) //Display has 8 pages
+  for(page = 0; page < pages; page++) //Display has 8 pages (DOGM132 has 4)
   {
+    burst_start();
     position(0,page);
-    digitalWrite(p_cs, LOW);
-    digitalWrite(p_a0, HIGH);
 
     for(column = 0; column < display_width(); column++) //clear the whole page line
-      spi_out(0x00);
+      burst_data(0x00);
 
-    digitalWrite(p_cs, HIGH);
+    burst_stop();
   }
+  invalidateCanvas();  // display does not show the canvas any more
 }
 
 /*----------------------------
@@ -173,8 +256,10 @@ Vars: byte contrast (0..63)
 ------------------------------*/
 void DogGraphicDisplay::contrast(byte contr)
 {
-  command(0x81);  //double byte command
-  command(contr&0x3F);  //contrast has only 6 bits
+  burst_start();
+  burst_command(0x81);  //double byte command
+  burst_command(contr&0x3F);  //contrast has only 6 bits
+  burst_stop();
 }
 
 /*----------------------------
@@ -187,11 +272,13 @@ void DogGraphicDisplay::view(byte direction)
   if(direction == VIEW_TOP)
   {
     top_view = true;
+    columnOffset = (type == DOGM132) ? 0 : 4;  // RAM is 132 columns wide, smaller displays are shifted in top view
     command(0xA0);
   }
   else
   {
     top_view = false;
+    columnOffset = 0;
     command(0xA1);
   }
 
@@ -278,44 +365,51 @@ Vars: column (0..127/131), page(0..3/7),  font address in program memory, string
 ------------------------------*/
 void DogGraphicDisplay::string(int column, byte page, const byte *font_adress, const char *str, byte align, byte style)
 {
-  unsigned int pos_array;  //Position of character data in memory array
+  DogProgmemAsset font(font_adress);
+
+  string(column, page, font, str, align, style);
+}
+
+/*----------------------------
+Func: string
+Desc: shows string with a font from an asset on position
+Vars: column (0..127/131), page(0..3/7), font, stringarray
+------------------------------*/
+void DogGraphicDisplay::string(int column, byte page, DogAsset &font, const char *str)
+{
+  string(column, page, font, str, ALIGN_LEFT, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: string
+Desc: shows string with a font from an asset on position with align
+Vars: column (0..127/131), page(0..3/7), font, stringarray, align
+------------------------------*/
+void DogGraphicDisplay::string(int column, byte page, DogAsset &font, const char *str, byte align)
+{
+  string(column, page, font, str, align, STYLE_NORMAL);
+}
+
+/*----------------------------
+Func: string
+Desc: shows string with a font from an asset on position with align and style, the characters are read while they are sent
+Vars: column (0..127/131), page(0..3/7), font, stringarray, align, style
+------------------------------*/
+void DogGraphicDisplay::string(int column, byte page, DogAsset &font, const char *str, byte align, byte style)
+{
   byte x, y, width_max,width_min;  //temporary column and page address, couloumn_cnt tand width_max are used to stay inside display area
   int column_cnt;  //temporary column and page address, couloumn_cnt tand width_max are used to stay inside display area
-  byte start_code, last_code, width, page_height, bytes_p_char; //font information, needed for calculation
+  byte page_height, invert; //font information, needed for calculation
   const char *string;
-  int stringwidth=0; // width of string in pixels
-
-#if defined(ARDUINO_ARCH_AVR)
-  start_code = pgm_read_byte(&font_adress[2]);  //get first defined character
-  last_code = pgm_read_byte(&font_adress[3]);  //get last defined character
-  width = pgm_read_byte(&font_adress[4]);  //width in pixel of one char
-  page_height = pgm_read_byte(&font_adress[6]);  //page count per char
-  bytes_p_char = pgm_read_byte(&font_adress[7]);  //bytes per char
-#else
-  start_code = font_adress[2];  //get first defined character
-  last_code = font_adress[3];  //get last defined character
-  width = font_adress[4];  //width in pixel of one char
-  page_height = font_adress[6];  //page count per char
-  bytes_p_char = font_adress[7];  //bytes per char
-#endif
+  int stringwidth; // width of string in pixels
+  DogBitmap glyph;
 
-  string = str;  //temporary pointer to the beginning of the string to print
-  while(*string != 0)
-  {
-    if((byte)*string < start_code || (byte)*string > last_code) //make sure data is valid
-      string++;
-    else
-    {
-      string++;
-      stringwidth++;
-    }
-  }
-  stringwidth*=width;
+  page_height = font.read(6);  //page count per char
+  stringwidth = canvas.textWidth(font, str);
+  invert = (style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) ? 0xFF : 0x00;
 
-  if(type != DOGM132 && page_height + page > 8) //stay inside display area
-    page_height = 8 - page;
-  else  if(type == DOGM132 && page_height + page > 4)
-    page_height = 4 - page;
+  if(page_height + page > page_cnt()) //stay inside display area
+    page_height = page_cnt() - page;
 
   if(align==ALIGN_RIGHT)
   {
@@ -328,62 +422,45 @@ void DogGraphicDisplay::string(int column, byte page, const byte *font_adress, c
   //the top page is printed first, then the next page and so on
   for(y = 0; y < page_height; y++)
   {
+    if(style==STYLE_FULL || style==STYLE_FULL_INVERSE) mark_ram_dirty(0, display_width()-1, page+y);
+    else mark_ram_dirty(column, column+stringwidth-1, page+y);
+    burst_start();
     if(style==STYLE_FULL || style==STYLE_FULL_INVERSE)
     {
       position(0, page+y); //set startpositon and page
       column_cnt=0;
-      digitalWrite(p_a0, HIGH);
-      digitalWrite(p_cs, LOW);
       while(column_cnt<column)  // fill columns until beginning of string
       {
         column_cnt++;
-        if(style==STYLE_FULL_INVERSE) spi_out(0xFF);
-        else spi_out(0);
+        burst_data(invert);
       }
     }
     else if(column<0) position(0,page+y);
     else position(column, page+y); //set startpositon and page
     column_cnt = column; //store column for display last column check
     string = str; //temporary pointer to the beginning of the string to print
-    digitalWrite(p_a0, HIGH);
-    digitalWrite(p_cs, LOW);
     while(*string != 0)
     {
       if(column_cnt>display_width()) string++;
-      else if(column_cnt+width<0)
-      {
-        string++;
-        column_cnt+=width;
-      }
-      else if((byte)*string < start_code || (byte)*string > last_code) //make sure data is valid
-        string++;
+      else if(!canvas.font_glyph(font, *string++, glyph, true)) continue; //make sure data is valid
+      else if(column_cnt+glyph.width<0) column_cnt+=glyph.width;
       else
       {
-        //calculate position of ascii character in font array
-        //bytes for header + (ascii - startcode) * bytes per char)
-        pos_array = 8 + (unsigned int)(*string++ - start_code) * bytes_p_char;
-        pos_array += y*width; //get the dot pattern for the part of the char to print
-
-        if((column_cnt + width) > display_width()) //stay inside display area
+        if((column_cnt + glyph.width) > display_width()) //stay inside display area
           width_max = display_width()-column_cnt;
         else
-          width_max = width;
+          width_max = glyph.width;
 
         if(column_cnt<0) width_min=0-column_cnt;
         else width_min=0;
 
+        DogCanvas::bitmap_skip(glyph, y*glyph.width + width_min); //get the dot pattern for the part of the char to print
         for(x=width_min; x < width_max; x++) //print the whole string
         {
-#if defined(ARDUINO_ARCH_AVR)
-          if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) spi_out(~pgm_read_byte(&font_adress[pos_array+x]));
-          else spi_out(pgm_read_byte(&font_adress[pos_array+x]));
-#else
-          if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) spi_out(~font_adress[pos_array+x]);
-          else spi_out(font_adress[pos_array+x]);
-#endif
+          burst_data(DogCanvas::bitmap_next(glyph) ^ invert);
           //spi_out(pgm_read_byte(&font_adress[pos_array+x])); //double width font (bold)
         }
-        column_cnt+=width;
+        column_cnt+=glyph.width;
       }
     }
     if(style==STYLE_FULL || style==STYLE_FULL_INVERSE)
@@ -392,11 +469,10 @@ void DogGraphicDisplay::string(int column, byte page, const byte *font_adress, c
       while(column_cnt<display_width())
       {
         column_cnt++;
-        if(style==STYLE_FULL_INVERSE) spi_out(0xFF);
-        else spi_out(0);
+        burst_data(invert);
       }
     }
-    digitalWrite(p_cs, HIGH);
+    burst_stop();
   }
 }
 
@@ -411,115 +487,89 @@ void DogGraphicDisplay::rectangle(byte start_column, byte start_page, byte end_c
 
   if(end_column>display_width())  //stay inside display area
     end_column=display_width();
-  if(type != DOGM132 && end_page > 7)
-    end_page = 7;
-  else if (type == DOGM132 && end_page > 3)
-    end_page = 3;
+  if(end_page >= page_cnt())
+    end_page = page_cnt() - 1;
 
   for(y=start_page; y<=end_page; y++)
   {
+    mark_ram_dirty(start_column, end_column, y);
+    burst_start();
     position(start_column, y);
-    digitalWrite(p_a0, HIGH);
-    digitalWrite(p_cs, LOW);
 
     for(x=start_column; x<=end_column; x++)
-      spi_out(pattern);
+      burst_data(pattern);
 
-    digitalWrite(p_cs, HIGH);
+    burst_stop();
   }
 }
 
 /*----------------------------
 Func: picture
-Desc: shows a BLH-picture on the display (see BitMapEdit EA LCD-Tools (http://www.lcd-module.de/support.html))
+Desc: shows a BLH-picture on the display (see BitMapEdit EA LCD-Tools (http://www.lcd-module.de/support.html)), also compressed
 Vars: column (0..127/131) and page(0..3/7), program memory address of data
 ------------------------------*/
 void DogGraphicDisplay::picture(byte column, byte page, const byte *pic_adress)
 {
-  byte c,p;
-  unsigned int byte_cnt = 2;
-  byte width,picture_width, page_cnt;
-
-#if defined(ARDUINO_ARCH_AVR)
-  picture_width = pgm_read_byte(&pic_adress[0]);
-  page_cnt = (pgm_read_byte(&pic_adress[1]) + 7) / 8; //height in pages, add 7 and divide by 8 for getting the used pages (byte boundaries)
-#else
-  picture_width = pic_adress[0];
-  page_cnt = (pic_adress[1] + 7) / 8; //height in pages, add 7 and divide by 8 for getting the used pages (byte boundaries)
-#endif
-
-  if((picture_width + column) > display_width()) //stay inside display area
-    width = display_width() - column;
-  else width=picture_width;
-
-  if(type != DOGM132 && page_cnt + page > 8)
-    page_cnt = 8 - page;
-  else if(type == DOGM132 && page_cnt + page > 4)
-    page_cnt = 4 - page;
+  picture(column, page, pic_adress, STYLE_NORMAL);
+}
 
-  for(p=0; p<page_cnt; p++)
-  {
-    byte_cnt=2+p*picture_width; // set byte counter to the correct start position in case that picture does not fit on screen
-    position(column, page + p);
-    digitalWrite(p_a0, HIGH);
-    digitalWrite(p_cs, LOW);
+/*----------------------------
+Func: picture with style
+Desc: shows a BLH-picture on the display (see BitMapEdit EA LCD-Tools (http://www.lcd-module.de/support.html)).
+      Compressed pictures (see DogCanvas.h) are decoded while they are sent, only the state of the decoder is kept in RAM.
+Vars: column (0..127/131) and page(0..3/7), program memory address of data, style (STYLE_NORMAL, STYLE_INVERSE)
+------------------------------*/
+void DogGraphicDisplay::picture(byte column, byte page, const byte *pic_adress, byte style)
+{
+  DogProgmemAsset pic(pic_adress);
 
-    for(c=0; c<width; c++)
-#if defined(ARDUINO_ARCH_AVR)
-      spi_out(pgm_read_byte(&pic_adress[byte_cnt++]));
-#else
-      spi_out(pic_adress[byte_cnt++]);
-#endif
+  picture(column, page, pic, style);
+}
 
-    digitalWrite(p_cs, HIGH);
-  }
+/*----------------------------
+Func: picture
+Desc: shows a BLH-picture (also compressed) from an asset on the display
+Vars: column (0..127/131) and page(0..3/7), picture
+------------------------------*/
+void DogGraphicDisplay::picture(byte column, byte page, DogAsset &pic)
+{
+  picture(column, page, pic, STYLE_NORMAL);
 }
 
 /*----------------------------
 Func: picture with style
-Desc: shows a BLH-picture on the display (see BitMapEdit EA LCD-Tools (http://www.lcd-module.de/support.html))
-Vars: column (0..127/131) and page(0..3/7), program memory address of data
+Desc: shows a BLH-picture (also compressed) from an asset on the display, the data is read while it is sent
+Vars: column (0..127/131) and page(0..3/7), picture, style (STYLE_NORMAL, STYLE_INVERSE)
 ------------------------------*/
-void DogGraphicDisplay::picture(byte column, byte page, const byte *pic_adress, byte style)
+void DogGraphicDisplay::picture(byte column, byte page, DogAsset &pic, byte style)
 {
+  DogBitmap bitmap;
   byte c,p;
-  unsigned int byte_cnt = 2;
   byte width,picture_width, page_cnt;
+  byte invert = (style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) ? 0xFF : 0x00;
 
-#if defined(ARDUINO_ARCH_AVR)
-  picture_width = pgm_read_byte(&pic_adress[0]);
-  page_cnt = (pgm_read_byte(&pic_adress[1]) + 7) / 8; //height in pages, add 7 and divide by 8 for getting the used pages (byte boundaries)
-#else
-  picture_width = pic_adress[0];
-  page_cnt = (pic_adress[1] + 7) / 8; //height in pages, add 7 and divide by 8 for getting the used pages (byte boundaries)
-#endif
+  picture_width = DogCanvas::picture_width(pic);
+  page_cnt = (DogCanvas::picture_height(pic) + 7) / 8; //height in pages, add 7 and divide by 8 for getting the used pages (byte boundaries)
+  DogCanvas::picture_start(bitmap, pic);
 
   if((picture_width + column) > display_width()) //stay inside display area
     width = display_width() - column;
   else width=picture_width;
 
-  if(type != DOGM132 && page_cnt + page > 8)
-    page_cnt = 8 - page;
-  else if(type == DOGM132 && page_cnt + page > 4)
-    page_cnt = 4 - page;
+  if(page_cnt + page > pageTotal)
+    page_cnt = pageTotal - page;
 
   for(p=0; p<page_cnt; p++)
   {
-    byte_cnt=2+p*picture_width; // set byte counter to the correct start position in case that picture does not fit on screen
+    mark_ram_dirty(column, column+width-1, page + p);
+    burst_start();
     position(column, page + p);
-    digitalWrite(p_a0, HIGH);
-    digitalWrite(p_cs, LOW);
 
     for(c=0; c<width; c++)
-#if defined(ARDUINO_ARCH_AVR)
-      if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) spi_out(~pgm_read_byte(&pic_adress[byte_cnt++]));
-      else spi_out(pgm_read_byte(&pic_adress[byte_cnt++]));
-#else
-      if(style==STYLE_INVERSE || style==STYLE_FULL_INVERSE) spi_out(~pic_adress[byte_cnt++]);
-      else spi_out(pic_adress[byte_cnt++]);
-#endif
+      burst_data(DogCanvas::bitmap_next(bitmap) ^ invert);
 
-    digitalWrite(p_cs, HIGH);
+    burst_stop();
+    DogCanvas::bitmap_skip(bitmap, picture_width - width);  // columns outside the display area
   }
 }
 
@@ -530,13 +580,7 @@ Vars: none
 ------------------------------*/
 byte DogGraphicDisplay::display_width (void)
 {
-  byte column_total=128;
-  if(type == DOGM132)
-    column_total = 132;
-  if(type == DOGS102)  // define different parameters for DOGS102
-    column_total = 102;
-
-  return column_total;
+  return columnTotal;  // set by panel_setup
 }
 /*----------------------------
 Func: page_cnt
@@ -545,13 +589,7 @@ Vars: none
 ------------------------------*/
 byte DogGraphicDisplay::page_cnt(void)
 {
-  byte page_cnt = 8;
-
-  if(type == DOGM132)
-  {
-    page_cnt = 4;
-  }
-  return page_cnt;
+  return pageTotal;  // set by panel_setup
 }
 
 /*----------------------------
@@ -559,59 +597,93 @@ Func: createCanvas
 Desc: creates Canvas
 Vars: canvas size and point of upper left corner, y-direction page aligned
 ------------------------------*/
+#if !defined(DOG_NO_HEAP)
 void DogGraphicDisplay::createCanvas(byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY)
 {
-  createCanvas(canvasSizeX, canvasSizeY, upperLeftX, upperLeftY, 0);
+  createCanvas(canvasSizeX, canvasSizeY, upperLeftX, upperLeftY, CANVAS_DIRECT);
 }
 
 /*----------------------------
 Func: createCanvas
-Desc: creates Canvas
-Vars: canvas size and point of upper left corner, y-direction page aligned, drawMode (0=direct to display, other=buffered)
+Desc: creates Canvas on the heap, a canvas created before is deleted
+Vars: canvas size and point of upper left corner, y-direction page aligned, drawMode (CANVAS_DIRECT=direct to display, CANVAS_BUFFERED=buffered,
+      CANVAS_DOUBLE_BUFFERED=buffered with second buffer for flushCanvasAsync)
 ------------------------------*/
 void DogGraphicDisplay::createCanvas(byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY, byte drawMode)
 {
-  this->canvasSizeX = canvasSizeX;
-  this->canvasSizeY = canvasSizeY;
+  byte frames = (drawMode == CANVAS_DOUBLE_BUFFERED) ? 2 : 1;
+
+  deleteCanvas();  // free the old canvas before allocating the new one
+  createCanvas(new byte[canvasBytes(canvasSizeX, canvasSizeY) * frames], canvasSizeX, canvasSizeY, upperLeftX, upperLeftY, drawMode);
+  canvasOwned = true;
+}
+#endif
+
+/*----------------------------
+Func: createCanvas
+Desc: creates Canvas in memory provided by the caller (e.g. a global array or DogStaticCanvas), nothing is allocated.
+      The buffer has to hold canvasBytes(canvasSizeX, canvasSizeY) bytes, twice as much for CANVAS_DOUBLE_BUFFERED.
+Vars: buffer, canvas size and point of upper left corner, y-direction page aligned, drawMode (CANVAS_DIRECT=direct to display,
+      CANVAS_BUFFERED=buffered, CANVAS_DOUBLE_BUFFERED=buffered with second buffer for flushCanvasAsync)
+------------------------------*/
+void DogGraphicDisplay::createCanvas(byte *buffer, byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY, byte drawMode)
+{
+  deleteCanvas();
+
   this->canvasUpperLeftX = upperLeftX;
   this->canvasUpperLeftY = upperLeftY;
   this->drawMode = drawMode;
 
-  byte rest = this->canvasSizeY % 8;
-
-  if(rest > 0)
-  {
-    for(int n = 1; n <= 8; n++)
-    {
-      int next = n * 8;
-      if(this->canvasSizeY < next)
-      {
-        this->canvasSizeY = next;
-        break;
-      }
-    }
-  }
-
-  canvasPages = this->canvasSizeY / 8;
-  canvas = new byte[canvasSizeX * canvasPages];
+  canvas.begin(buffer, canvasSizeX, canvasSizeY);  // y-direction page aligned
+  canvas.display = this;
+  canvasOwned = false;
+  if(drawMode == CANVAS_DOUBLE_BUFFERED)
+    canvasFront = buffer + canvasBytes(canvasSizeX, canvasSizeY);
 
+  area_update();
+  scrollY0 = 0;
+  scrollY1 = -1;
+  invalidateCanvas();  // display content is unknown, so first flush sends everything
+}
 
-  for(int x = 0; x < canvasSizeX; x++)
-  {
-    for(int page = 0; page < canvasPages; page ++)
-    {
-      canvas[page * canvasSizeX + x] = 0;
-    }
-  }
+/*----------------------------
+Func: canvasBytes
+Desc: returns the memory needed for a canvas
+Vars: canvas size
+------------------------------*/
+unsigned int DogGraphicDisplay::canvasBytes(byte canvasSizeX, byte canvasSizeY)
+{
+  return DogCanvas::bytes(canvasSizeX, canvasSizeY);
 }
 
 /*----------------------------
 Func: deleteCanvas
-Desc: deletes Canvas so memory is free again
+Desc: deletes Canvas so memory is free again, memory of the caller is not freed
 ------------------------------*/
 void DogGraphicDisplay::deleteCanvas()
 {
-  delete[] canvas;
+  waitFlush();  // the second buffer may still be in use
+#if !defined(DOG_NO_HEAP)
+  if(canvasOwned)
+    delete[] (canvasFront != NULL && canvasFront < canvas.buffer ? canvasFront : canvas.buffer);  // buffers may be swapped by flushCanvasAsync
+#endif
+  canvas.display = NULL;
+  canvas.end();
+  canvasFront = NULL;
+  canvasOwned = false;
+  drawMode = CANVAS_BUFFERED;
+  clear_dirty();
+  area_update();
+}
+
+/*----------------------------
+Func: getCanvas
+Desc: returns the canvas of createCanvas, e.g. to show sprites on it (see DogSprite)
+Vars: none
+------------------------------*/
+DogCanvas &DogGraphicDisplay::getCanvas()
+{
+  return canvas;
 }
 
 /*----------------------------
@@ -621,31 +693,7 @@ Vars: x, y coordinates, value(true = black, false = white
 ------------------------------*/
 void DogGraphicDisplay::setPixel(int x, int y, bool value)
 {
-//  x += canvasUpperLeftX;
-//  y += canvasUpperLeftY;
-
-  if(x < canvasSizeX && y < canvasSizeY && x >= 0 && y >= 0) // check if pixel is within canvas
-  {
-
-    byte page = (y * canvasPages) / canvasSizeY;
-    y = y - 8 * page;
-    if(value)
-    {
-      canvas[page * canvasSizeX + x] |= (1<<y);
-    }
-    else
-    {
-      canvas[page * canvasSizeX + x] &= ~(1<<y);
-    }
-
-    if(drawMode==0)
-    {
-      if((x+canvasUpperLeftX)>=0&&(x+canvasUpperLeftX)<display_width()&&(page+canvasUpperLeftY)>=0&&(page+canvasUpperLeftY)<page_cnt())  // check if pixel is within display
-      {
-        rectangle(x+canvasUpperLeftX, page+canvasUpperLeftY, x+canvasUpperLeftX, page+canvasUpperLeftY, canvas[page * canvasSizeX + x]);
-      }
-    }
-  }
+  canvas.setPixel(x, y, value);
 }
 
 /*----------------------------
@@ -655,17 +703,7 @@ Vars: start and end coordinates
 ------------------------------*/
 void DogGraphicDisplay::drawLine(int x0, int y0, int x1, int y1)
 {
-  int dx = abs(x1-x0), sx = x0<x1 ? 1 : -1;
-  int dy = abs(y1-y0), sy = y0<y1 ? 1 : -1;
-  int err = (dx>dy ? dx : -dy)/2, e2;
-
-  for(;;){
-    setPixel(x0,y0, true);
-    if (x0==x1 && y0==y1) break;
-    e2 = err;
-    if (e2 >-dx) { err -= dy; x0 += sx; }
-    if (e2 < dy) { err += dx; y0 += sy; }
-  }
+  canvas.drawLine(x0, y0, x1, y1);
 }
 
 /*----------------------------
@@ -675,9 +713,7 @@ Vars: start and end coordinates, the head is at the end coordinates
 ------------------------------*/
 void DogGraphicDisplay::drawArrow(int x0, int y0, int x1, int y1)
 {
-  drawLine(x0,y0,x1,y1);
-  drawLine(x1-(x1-x0)/6-(y1-y0)/6,y1-(y1-y0)/6+(x1-x0)/6,x1,y1);
-  drawLine(x1-(x1-x0)/6+(y1-y0)/6,y1-(y1-y0)/6-(x1-x0)/6,x1,y1);
+  canvas.drawArrow(x0, y0, x1, y1);
 }
 
 /*----------------------------
@@ -687,43 +723,7 @@ Vars: center coordinates, radius, fill( true = filled, false = not filled )
 ------------------------------*/
 void DogGraphicDisplay::drawCircle(int x0, int y0, int r, bool fill)
 {
-  int x = r;
-  int y = 0;
-  int err = 0;
-
-  while (x >= y)
-  {
-    if(!fill)
-    {
-      setPixel(x0 + x, y0 + y, true);
-      setPixel(x0 + y, y0 + x, true);
-      setPixel(x0 - y, y0 + x, true);
-      setPixel(x0 - x, y0 + y, true);
-      setPixel(x0 - x, y0 - y, true);
-      setPixel(x0 - y, y0 - x, true);
-      setPixel(x0 + y, y0 - x, true);
-      setPixel(x0 + x, y0 - y, true);
-    }
-    else
-    {
-      drawLine(x0 + x, y0 + y, x0 - x, y0 + y);
-      drawLine(x0 + y, y0 + x, x0 - y, y0 + x);
-      drawLine(x0 - x, y0 - y, x0 + x, y0 - y);
-      drawLine(x0 - y, y0 - x, x0 + y, y0 - x);
-    }
-
-    if (err <= 0)
-    {
-      y += 1;
-      err += 2*y + 1;
-    }
-
-    if (err > 0)
-    {
-      x -= 1;
-      err -= 2*x + 1;
-    }
-  }
+  canvas.drawCircle(x0, y0, r, fill);
 }
 
 /*----------------------------
@@ -733,20 +733,7 @@ Vars: coordinates of upper left corner, width and height, fill( true = filled, f
 ------------------------------*/
 void DogGraphicDisplay::drawRect(int x0, int y0, int width, int height, bool fill)
 {
-  if(!fill)
-  {
-    drawLine(x0, y0, x0 + width, y0);
-    drawLine(x0, y0 + height, x0 + width, y0 + height);
-    drawLine(x0, y0, x0, y0 + height);
-    drawLine(x0 + width, y0, x0 + width, y0 + height);
-  }
-  else
-  {
-    for(int y = y0; y <= y0 + height; y++)
-    {
-      drawLine(x0, y, x0 + width, y);
-    }
-  }
+  canvas.drawRect(x0, y0, width, height, fill);
 }
 
 /*----------------------------
@@ -756,126 +743,1193 @@ Vars: center coordinates, width and height
 ------------------------------*/
 void DogGraphicDisplay::drawCross(int x0, int y0, int width, int height)
 {
-  drawLine(x0 - width, y0 - height, x0 + width, y0 + height);
-  drawLine(x0 - width, y0 + height, x0 + width, y0 - height);
+  canvas.drawCross(x0, y0, width, height);
 }
 
 /*----------------------------
-Func: clearCanvas
-Desc: sets all pixel of the canvas to 0
-Vars: none
+Func: drawString
+Desc: draws a string with selected font into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, font address in program memory, stringarray
 ------------------------------*/
-void DogGraphicDisplay::clearCanvas(void)
+void DogGraphicDisplay::drawString(int x, int y, const byte *font_adress, const char *str)
 {
-  for(int x = 0; x < canvasSizeX; x++)
-  {
-    for(int y = 0; y < canvasSizeY; y++)
-    {
-      setPixel(x,y,0);
-    }
-  }
+  canvas.drawString(x, y, font_adress, str);
 }
 
 /*----------------------------
-Func: flushCanvas
-Desc: sends all pixel of the canvas to the display
-Vars: coordinates of upper left corner
+Func: drawString
+Desc: draws a string with selected font into the canvas at any pixel position. The glyph cells are written as whole bytes,
+      shifted across two canvas pages if y is not page aligned. STYLE_FULL and STYLE_FULL_INVERSE also fill the text rows left and right of the string.
+Vars: x, y coordinates of upper left corner, font address in program memory, stringarray, style
 ------------------------------*/
-void DogGraphicDisplay::flushCanvas(int upperLeftX, int upperLeftY)
+void DogGraphicDisplay::drawString(int x, int y, const byte *font_adress, const char *str, byte style)
 {
-  this->canvasUpperLeftX = upperLeftX;
-  this->canvasUpperLeftY = upperLeftY;
-  flushCanvas();
+  canvas.drawString(x, y, font_adress, str, style);
 }
 
 /*----------------------------
-Func: flushCanvas
-Desc: sends all pixel of the canvas to the display
-Vars: none
+Func: textWidth
+Desc: returns the width of a string in pixels, characters that are not in the font are skipped
+Vars: font address in program memory, stringarray
 ------------------------------*/
-void DogGraphicDisplay::flushCanvas(void)
+int DogGraphicDisplay::textWidth(const byte *font_adress, const char *str)
 {
-  for(int page = 0; page < canvasPages; page++)
-  {
-    if((page+canvasUpperLeftY)>=0&&(page+canvasUpperLeftY)<page_cnt())  // check if page is within display
-    {
-      int x=0;
-      if(canvasUpperLeftX>=0) position(canvasUpperLeftX, page+canvasUpperLeftY);
-      else
-      {
-        position(0, page+canvasUpperLeftY);
-        x=-canvasUpperLeftX;
-      }
-      digitalWrite(p_a0, HIGH);
-      digitalWrite(p_cs, LOW);
+  return canvas.textWidth(font_adress, str);
+}
 
-      for( ; ((x < canvasSizeX)&&((x+canvasUpperLeftX)<display_width())); x++)  // also check if x is within display
-      {
-        spi_out(canvas[page * canvasSizeX + x]);
-      }
+/*----------------------------
+Func: textHeight
+Desc: returns the height of one line of text in pixels (whole pages, like it is drawn)
+Vars: font address in program memory
+------------------------------*/
+int DogGraphicDisplay::textHeight(const byte *font_adress)
+{
+  return canvas.textHeight(font_adress);
+}
 
-      digitalWrite(p_cs, HIGH);
-    }
-  }
+/*----------------------------
+Func: textHeight
+Desc: returns the height in pixels of a string that is wrapped like in drawTextBox
+Vars: font address in program memory, stringarray, width of the text box
+------------------------------*/
+int DogGraphicDisplay::textHeight(const byte *font_adress, const char *str, int width)
+{
+  return canvas.textHeight(font_adress, str, width);
 }
 
-//----------------------------------------------------private Functions----------------------------------------------------
-//normally you don't need those functions in your sketch
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string into a rectangle of the canvas, see drawTextBox with style
+Vars: x, y coordinates of upper left corner, width and height of the box, font address in program memory, stringarray, align
+------------------------------*/
+void DogGraphicDisplay::drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align)
+{
+  canvas.drawTextBox(x, y, width, height, font_adress, str, align);
+}
 
 /*----------------------------
-Func: position
-Desc: sets write pointer in DOG-Display
-Vars: column (0..127/131), page(0..3/7)
+Func: drawTextBox
+Desc: draws a string into a rectangle of the canvas. Lines are wrapped after the last word that fits (or inside a word that
+      is longer than the box) and at '\n'. If the text needs more lines than the box has, the last line ends with "...".
+      Nothing is drawn outside the box, STYLE_FULL and STYLE_FULL_INVERSE fill the whole box.
+Vars: x, y coordinates of upper left corner, width and height of the box, font address in program memory, stringarray,
+      align (ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER combined with ALIGN_TOP, ALIGN_MIDDLE or ALIGN_BOTTOM), style
 ------------------------------*/
-void DogGraphicDisplay::position(byte column, byte page)
+void DogGraphicDisplay::drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align, byte style)
 {
-  if(top_view && type != DOGM132)
-    column += 4;
+  canvas.drawTextBox(x, y, width, height, font_adress, str, align, style);
+}
 
-  command(0x10 + (column>>4)); //MSB address column
-  command(0x00 + (column&0x0F)); //LSB address column
-  command(0xB0 + (page&0x0F)); //address page
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture (see picture) into the canvas at any pixel position, also partly outside the canvas
+Vars: x, y coordinates of upper left corner, program memory address of data, raster operation (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogGraphicDisplay::blit(int x, int y, const byte *pic_adress, byte rop)
+{
+  canvas.blit(x, y, pic_adress, rop);
 }
 
 /*----------------------------
-Func: command
-Desc: Sends a command to the DOG-Display
-Vars: data
+Func: blit
+Desc: draws a BLH-picture into the canvas, only the pixels that are set in the mask (a BLH-picture of the same size) are changed
+Vars: x, y coordinates of upper left corner, program memory address of picture and mask, raster operation
 ------------------------------*/
-void DogGraphicDisplay::command(byte dat)
+void DogGraphicDisplay::blit(int x, int y, const byte *pic_adress, const byte *mask_adress, byte rop)
 {
-  digitalWrite(p_a0, LOW);
-  spi_put_byte(dat);
+  canvas.blit(x, y, pic_adress, mask_adress, rop);
 }
 
 /*----------------------------
-Func: data
-Desc: Sends data to the DOG-Display
-Vars: data
+Func: drawString
+Desc: draws a string with a font from an asset into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, font, stringarray
 ------------------------------*/
-void DogGraphicDisplay::data(byte dat)
+void DogGraphicDisplay::drawString(int x, int y, DogAsset &font, const char *str)
 {
-  digitalWrite(p_a0, HIGH);
-  spi_put_byte(dat);
+  canvas.drawString(x, y, font, str);
 }
 
 /*----------------------------
-Func: spi_initialize
-Desc: Initializes SPI Hardware/Software
-Vars: CS-Pin, MOSI-Pin, SCK-Pin (MOSI=SCK Hardware else Software)
+Func: drawString
+Desc: draws a string with a font from an asset into the canvas at any pixel position, see drawString with font address
+Vars: x, y coordinates of upper left corner, font, stringarray, style
 ------------------------------*/
-void DogGraphicDisplay::spi_initialize(byte cs, byte si, byte clk)
+void DogGraphicDisplay::drawString(int x, int y, DogAsset &font, const char *str, byte style)
 {
-  //Set pin Configuration
-  p_cs = cs;
+  canvas.drawString(x, y, font, str, style);
+}
 
-  if(si == clk)
-  {
-    hardware = true;
-    p_si = MOSI;
-    p_clk = SCK;
-    DogGraphicDisplay::spi_port = &SPI;
-  }
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture (also compressed) from an asset into the canvas at any pixel position
+Vars: x, y coordinates of upper left corner, picture, raster operation (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT)
+------------------------------*/
+void DogGraphicDisplay::blit(int x, int y, DogAsset &pic, byte rop)
+{
+  canvas.blit(x, y, pic, rop);
+}
+
+/*----------------------------
+Func: blit
+Desc: draws a BLH-picture from an asset into the canvas, only the pixels that are set in the mask are changed
+Vars: x, y coordinates of upper left corner, picture and mask (same size), raster operation
+------------------------------*/
+void DogGraphicDisplay::blit(int x, int y, DogAsset &pic, DogAsset &mask, byte rop)
+{
+  canvas.blit(x, y, pic, mask, rop);
+}
+
+/*----------------------------
+Func: textWidth
+Desc: returns the width of a string in pixels, characters that are not in the font are skipped
+Vars: font, stringarray
+------------------------------*/
+int DogGraphicDisplay::textWidth(DogAsset &font, const char *str)
+{
+  return canvas.textWidth(font, str);
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height of one line of text in pixels (whole pages, like it is drawn)
+Vars: font
+------------------------------*/
+int DogGraphicDisplay::textHeight(DogAsset &font)
+{
+  return canvas.textHeight(font);
+}
+
+/*----------------------------
+Func: textHeight
+Desc: returns the height in pixels of a string that is wrapped like in drawTextBox
+Vars: font, stringarray, width of the text box
+------------------------------*/
+int DogGraphicDisplay::textHeight(DogAsset &font, const char *str, int width)
+{
+  return canvas.textHeight(font, str, width);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string with a font from an asset into a rectangle of the canvas, see drawTextBox with style
+Vars: x, y coordinates of upper left corner, width and height of the box, font, stringarray, align
+------------------------------*/
+void DogGraphicDisplay::drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align)
+{
+  canvas.drawTextBox(x, y, width, height, font, str, align);
+}
+
+/*----------------------------
+Func: drawTextBox
+Desc: draws a string with a font from an asset into a rectangle of the canvas, see drawTextBox with font address
+Vars: x, y coordinates of upper left corner, width and height of the box, font, stringarray, align, style
+------------------------------*/
+void DogGraphicDisplay::drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align, byte style)
+{
+  canvas.drawTextBox(x, y, width, height, font, str, align, style);
+}
+
+/*----------------------------
+Func: pushClip
+Desc: limits all drawing on the canvas to a rectangle inside the current clip rectangle, the current one is saved
+Vars: coordinates of upper left corner, width and height, returns false if too many clip rectangles are pushed
+------------------------------*/
+bool DogGraphicDisplay::pushClip(int x, int y, int width, int height)
+{
+  return canvas.pushClip(x, y, width, height);
+}
+
+/*----------------------------
+Func: popClip
+Desc: restores the clip rectangle that was active before the last pushClip
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::popClip(void)
+{
+  canvas.popClip();
+}
+
+/*----------------------------
+Func: clearCanvas
+Desc: sets all pixel of the canvas to 0
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::clearCanvas(void)
+{
+  canvas.clear();
+}
+
+/*----------------------------
+Func: flushCanvas
+Desc: sends all pixel of the canvas to the display
+Vars: coordinates of upper left corner
+------------------------------*/
+void DogGraphicDisplay::flushCanvas(int upperLeftX, int upperLeftY)
+{
+  this->canvasUpperLeftX = upperLeftX;
+  this->canvasUpperLeftY = upperLeftY;
+  area_update();
+  invalidateCanvas();  // canvas moved, so every visible byte has to be sent
+  flushCanvas();
+}
+
+/*----------------------------
+Func: flushCanvas
+Desc: sends the changed column spans of the canvas and the layers to the display
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::flushCanvas(void)
+{
+  if(canvas.buffer == NULL && layerCount == 0) return;
+  if(drawMode==CANVAS_DIRECT) invalidateCanvas();  // direct mode does not track changes, so send everything
+#if defined(DOG_STATS)
+  unsigned long start = micros();
+#endif
+  flush_dirty();
+#if defined(DOG_STATS)
+  stats_flush(start);
+#endif
+}
+
+/*----------------------------
+Func: flushCanvasAsync
+Desc: hands the changed spans of the canvas to the flush backend and returns while they are sent. Needs a canvas with
+      CANVAS_DOUBLE_BUFFERED: the buffers are swapped, the finished frame is sent and drawing continues in the other buffer,
+      which starts with a copy of the finished frame. Without second buffer the canvas is flushed at once. Without backend
+      all pages are sent before it returns, CS is high again and the bus is free for other devices.
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::flushCanvasAsync(void)
+{
+  byte *finished;
+
+  if(canvas.buffer == NULL && layerCount == 0) return;
+  if(canvasFront == NULL)
+  {
+    flushCanvas();
+    return;
+  }
+  waitFlush();  // second buffer is free after the last flush
+  if(bus != NULL) bus->acquire(this);
+
+  finished = canvas.buffer;
+  canvas.buffer = canvasFront;
+  canvasFront = finished;
+  memcpy(canvas.buffer, canvasFront, canvas.sizeX * canvas.pages);
+
+  for(int page = 0; page < DOG_MAX_PAGES; page++)  // changes of this frame are sent, new changes are collected
+  {
+    flushStart[page] = dirtyStart[page];
+    flushEnd[page] = dirtyEnd[page];
+  }
+  clear_dirty();
+  flushUpperLeftX = canvasUpperLeftX;
+  flushUpperLeftY = canvasUpperLeftY;
+  flushPage = 0;
+  flushActive = true;
+#if defined(DOG_STATS)
+  flushStartTime = micros();
+#endif
+  if(bus != NULL) bus->active = this;  // other displays wait until this flush has finished
+  flush_async_next();
+  if(flushBackend == NULL) waitFlush();  // pages sent by software, closes the burst of every page
+}
+
+/*----------------------------
+Func: isFlushBusy
+Desc: returns true while flushCanvasAsync is sending, starts the next page when the backend finished the last one
+Vars: none
+------------------------------*/
+bool DogGraphicDisplay::isFlushBusy(void)
+{
+  if(!flushActive) return false;
+  if(flushBackend != NULL && flushBackend->isBusy()) return true;
+  burst_stop();  // last page finished
+  flush_async_next();
+  return flushActive;
+}
+
+/*----------------------------
+Func: waitFlush
+Desc: waits until flushCanvasAsync has sent everything
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::waitFlush(void)
+{
+  while(isFlushBusy());
+}
+
+/*----------------------------
+Func: setFlushBackend
+Desc: sets the backend for flushCanvasAsync, e.g. a DMA transfer. Without backend the pages are sent at once.
+Vars: pointer to backend (NULL = no backend)
+------------------------------*/
+void DogGraphicDisplay::setFlushBackend(DogFlushBackend *backend)
+{
+  waitFlush();
+  flushBackend = backend;
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: enableShadow
+Desc: keeps a copy of the display RAM on the heap, so flushCanvas only sends bytes that really differ. Clears the display to start with a known content.
+Vars: state (false=no copy, true=keep copy of display RAM)
+------------------------------*/
+void DogGraphicDisplay::enableShadow(bool state)
+{
+  enableShadow((byte *)NULL);
+  if(state)
+  {
+    enableShadow(new byte[display_width() * page_cnt()]);
+    shadowOwned = true;
+  }
+}
+#endif
+
+/*----------------------------
+Func: enableShadow
+Desc: keeps a copy of the display RAM in memory provided by the caller (display_width() * page_cnt() bytes). Clears the display to start with a known content.
+Vars: buffer (NULL = no copy)
+------------------------------*/
+void DogGraphicDisplay::enableShadow(byte *buffer)
+{
+#if !defined(DOG_NO_HEAP)
+  if(shadowOwned)
+    delete[] shadow;
+#endif
+  shadow = buffer;
+  shadowOwned = false;
+  if(buffer != NULL)
+  {
+    memset(shadow, 0, display_width() * page_cnt());
+    clear();  // display and copy are both empty now
+  }
+}
+
+/*----------------------------
+Func: scrollTo
+Desc: sets the display start line, see scrollBy
+Vars: display RAM line shown in the top row (0..63)
+------------------------------*/
+void DogGraphicDisplay::scrollTo(byte line)
+{
+  scrollBy((line & 63) - scrollLine);
+}
+
+/*----------------------------
+Func: scrollBy
+Desc: scrolls the display with the display start line command, so the content is not sent again. The display RAM has 64 rows,
+      rows that leave the display on one side come back on the other side. The canvas content is moved the same way and the
+      rows that moved into the canvas are cleared, draw the new content there (see getScrollArea) and flush the canvas.
+      Canvas rows are mapped to the scrolled display RAM, but page functions (string, picture, rectangle) use RAM pages (see scrollPage).
+Vars: rows (positive = content moves up, new rows at the bottom)
+------------------------------*/
+void DogGraphicDisplay::scrollBy(int dy)
+{
+  dy %= 64;
+  if(dy == 0) return;
+  waitFlush();
+  if(canvas.buffer != NULL || layerCount > 0) canvas_scroll(dy);
+
+  scrollLine = (scrollLine + dy) & 63;
+  command(0x40 | scrollLine);  //display start line
+  if(drawMode == CANVAS_DIRECT) flush_dirty();
+}
+
+/*----------------------------
+Func: getScroll
+Desc: returns the display start line
+Vars: none
+------------------------------*/
+byte DogGraphicDisplay::getScroll(void)
+{
+  return scrollLine;
+}
+
+/*----------------------------
+Func: getScrollArea
+Desc: returns the canvas rows that were cleared by the last scrollBy and need new content
+Vars: references for first and last row (canvas coordinates), returns false without canvas or scrolling
+------------------------------*/
+bool DogGraphicDisplay::getScrollArea(int &y0, int &y1)
+{
+  if(canvas.buffer == NULL || scrollY0 > scrollY1) return false;
+  y0 = scrollY0;
+  y1 = scrollY1;
+  return true;
+}
+
+/*----------------------------
+Func: scrollPage
+Desc: returns the display RAM page, that is shown at a page of the display while it is scrolled by a multiple of 8 rows.
+      Use it for the page functions string, picture and rectangle.
+Vars: visible page
+------------------------------*/
+byte DogGraphicDisplay::scrollPage(byte page)
+{
+  return (page + (scrollLine >> 3)) & (DOG_MAX_PAGES - 1);
+}
+
+/*----------------------------
+Func: setGlyphCache
+Desc: uses a RAM cache for the characters of string and drawString, one cache can be used by several displays and canvases
+Vars: pointer to cache (NULL = read characters from the font)
+------------------------------*/
+void DogGraphicDisplay::setGlyphCache(DogGlyphCache *cache)
+{
+  canvas.setGlyphCache(cache);
+}
+
+/*----------------------------
+Func: addLayer
+Desc: shows a canvas on top of the canvas of createCanvas and the layers added before. The pages are put together while they
+      are sent, so the layers need no memory on the display side. Changes of the layer are sent like changes of the canvas
+      (at once with CANVAS_DIRECT, else with flushCanvas). Display columns between the canvas and the layers are sent as 0.
+Vars: canvas, point of upper left corner (y-direction in pages), rop (ROP_COPY, ROP_OR, ROP_AND, ROP_XOR, ROP_NOT) combines the layer
+      with the content below, returns false if DOG_MAX_LAYERS are used or the canvas is shown already
+------------------------------*/
+bool DogGraphicDisplay::addLayer(DogCanvas &layer, int upperLeftX, int upperLeftY, byte rop)
+{
+  if(layerCount >= DOG_MAX_LAYERS || layer.display != NULL) return false;
+  waitFlush();  // flushCanvasAsync reads the layers while it is sending
+
+  layers[layerCount].canvas = &layer;
+  layers[layerCount].upperLeftX = upperLeftX;
+  layers[layerCount].upperLeftY = upperLeftY;
+  layers[layerCount].rop = rop;
+  layer.display = this;
+  layerCount++;
+  area_update();
+  mark_layer(layerCount - 1);
+  if(drawMode==CANVAS_DIRECT) flush_dirty();
+  return true;
+}
+
+/*----------------------------
+Func: moveLayer
+Desc: moves a layer, the area it covered before is sent again
+Vars: canvas, point of upper left corner (y-direction in pages)
+------------------------------*/
+void DogGraphicDisplay::moveLayer(DogCanvas &layer, int upperLeftX, int upperLeftY)
+{
+  for(byte i = 0; i < layerCount; i++)
+  {
+    if(layers[i].canvas != &layer) continue;
+    waitFlush();
+    mark_layer(i);
+    layers[i].upperLeftX = upperLeftX;
+    layers[i].upperLeftY = upperLeftY;
+    area_update();
+    mark_layer(i);
+    if(drawMode==CANVAS_DIRECT) flush_dirty();
+    return;
+  }
+}
+
+/*----------------------------
+Func: removeLayer
+Desc: removes a layer, the area it covered is sent again. Also called by DogCanvas::end.
+Vars: canvas
+------------------------------*/
+void DogGraphicDisplay::removeLayer(DogCanvas &layer)
+{
+  for(byte i = 0; i < layerCount; i++)
+  {
+    if(layers[i].canvas != &layer) continue;
+    waitFlush();
+    mark_layer(i);  // still inside the area, the span is kept when the area gets smaller
+    layerCount--;
+    for( ; i < layerCount; i++)
+      layers[i] = layers[i + 1];
+    layer.display = NULL;
+    area_update();
+    if(drawMode==CANVAS_DIRECT) flush_dirty();
+    return;
+  }
+}
+
+/*----------------------------
+Func: invalidateCanvas
+Desc: marks the whole canvas as changed, so the next flushCanvas sends every visible byte
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::invalidateCanvas(void)
+{
+  for(int page = 0; page < page_cnt(); page++)
+    mark_dirty(0, display_width()-1, page);
+}
+
+/*----------------------------
+Func: getDirtyArea
+Desc: returns the bounding box of the changes, that the next flushCanvas will send
+Vars: references for upper left and lower right corner in canvas coordinates, returns false if nothing changed
+------------------------------*/
+bool DogGraphicDisplay::getDirtyArea(int &x0, int &y0, int &x1, int &y1)
+{
+  int column_min = DOG_MAX_PAGES * 0x100, column_max = -1, page_min = -1, page_max = -1;
+
+  for(int page = 0; page < DOG_MAX_PAGES; page++)
+  {
+    if(dirtyStart[page] <= dirtyEnd[page])
+    {
+      if(page_min < 0) page_min = page;
+      page_max = page;
+      if(dirtyStart[page] < column_min) column_min = dirtyStart[page];
+      if(dirtyEnd[page] > column_max) column_max = dirtyEnd[page];
+    }
+  }
+  if(page_min < 0) return false;
+
+  x0 = column_min - canvasUpperLeftX;
+  x1 = column_max - canvasUpperLeftX;
+  y0 = (page_min - canvasUpperLeftY) * 8;
+  y1 = (page_max - canvasUpperLeftY) * 8 + 7;
+  return true;
+}
+
+/*----------------------------
+Func: dirtyBytes
+Desc: returns the count of data bytes, that the next flushCanvas will send
+Vars: none
+------------------------------*/
+unsigned int DogGraphicDisplay::dirtyBytes(void)
+{
+  unsigned int bytes = 0;
+
+  for(int page = 0; page < DOG_MAX_PAGES; page++)
+  {
+    if(dirtyStart[page] <= dirtyEnd[page])
+      bytes += dirtyEnd[page] - dirtyStart[page] + 1;
+  }
+  return bytes;
+}
+
+#if defined(DOG_STATS)
+/*----------------------------
+Func: getStats
+Desc: returns the counters since the last resetStats: data and command bytes, positions, flushes with their time and
+      the pixels written into the canvas. Only with DOG_STATS defined in the build flags.
+Vars: none
+------------------------------*/
+DogStats DogGraphicDisplay::getStats(void)
+{
+  DogStats result = stats;
+
+  if(stats.flushes) result.flushTimeAvg = flushTimeSum / stats.flushes;
+  result.pixels = canvas.pixels;
+  return result;
+}
+
+/*----------------------------
+Func: resetStats
+Desc: sets all counters to 0
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::resetStats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+  flushTimeSum = 0;
+  flushStartTime = 0;
+  canvas.resetPixelCount();
+}
+#endif
+
+//----------------------------------------------------private Functions----------------------------------------------------
+//normally you don't need those functions in your sketch
+
+/*----------------------------
+Func: panel_setup
+Desc: stores the geometry of the display type and sends the init sequence
+Vars: type (DOGM128, DOGL128, DOGM132, DOGS102)
+------------------------------*/
+void DogGraphicDisplay::panel_setup(byte type)
+{
+  byte *ptr_init = init_DOGM128; //default pointer for wrong parameters
+  int init_len = INITLEN;
+
+  if(type == DOGL128) ptr_init = init_DOGL128;
+  else if(type == DOGM132) ptr_init = init_DOGM132;
+  else if(type == DOGS102)
+  {
+    ptr_init = init_DOGS102;
+    init_len = INITLEN_DOGS102;  // shorter init for DOGS102
+  }
+
+  DogGraphicDisplay::type = type;
+  columnTotal = (type == DOGM132) ? 132 : ((type == DOGS102) ? 102 : 128);
+  pageTotal = (type == DOGM132) ? 4 : 8;
+  columnOffset = 0;  // bottom view
+  scrollLine = 0;  // init sets start line 0
+  scrollY0 = 0;
+  scrollY1 = -1;
+
+  spi_put(ptr_init, init_len);
+}
+
+/*----------------------------
+Func: canvas_changed
+Desc: called after a column span of a canvas page was changed. Direct mode sends it to the display at once, buffered mode marks it for the next flush
+Vars: canvas or layer, start and end column, page (coordinates of the canvas)
+------------------------------*/
+void DogGraphicDisplay::canvas_changed(DogCanvas *source, int start_column, int end_column, int page)
+{
+  int x = canvasUpperLeftX, y = canvasUpperLeftY;
+
+  for(byte i = 0; i < layerCount; i++)
+  {
+    if(layers[i].canvas == source)
+    {
+      x = layers[i].upperLeftX;
+      y = layers[i].upperLeftY;
+    }
+  }
+  mark_dirty(start_column + x, end_column + x, page + y);
+  if(drawMode==CANVAS_DIRECT) flush_dirty();
+}
+
+/*----------------------------
+Func: area_update
+Desc: sets the area covered by the canvas and the layers, mark_dirty keeps the changes inside.
+      If the area gets larger, all of it is sent again because the display columns between canvas and layers were not kept up to date.
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::area_update(void)
+{
+  const DogCanvas *source;
+  int x, y;
+  int x0 = areaX0, x1 = areaX1, page0 = areaPage0, page1 = areaPage1;
+
+  areaX0 = 0;  // empty
+  areaX1 = -1;
+  areaPage0 = 0;
+  areaPage1 = -1;
+  for(int i = -1; i < layerCount; i++)  // canvas of createCanvas first
+  {
+    source = (i < 0) ? &canvas : layers[i].canvas;
+    x = (i < 0) ? canvasUpperLeftX : layers[i].upperLeftX;
+    y = (i < 0) ? canvasUpperLeftY : layers[i].upperLeftY;
+    if(source->buffer == NULL || source->sizeX == 0 || source->pages == 0) continue;
+
+    if(areaX0 > areaX1)
+    {
+      areaX0 = x;
+      areaX1 = x + source->sizeX - 1;
+      areaPage0 = y;
+      areaPage1 = y + source->pages - 1;
+    }
+    else
+    {
+      if(x < areaX0) areaX0 = x;
+      if(x + source->sizeX - 1 > areaX1) areaX1 = x + source->sizeX - 1;
+      if(y < areaPage0) areaPage0 = y;
+      if(y + source->pages - 1 > areaPage1) areaPage1 = y + source->pages - 1;
+    }
+  }
+  if(areaX0 <= areaX1 && (x0 > x1 || areaX0 < x0 || areaX1 > x1 || areaPage0 < page0 || areaPage1 > page1))
+    invalidateCanvas();
+}
+
+/*----------------------------
+Func: mark_layer
+Desc: marks the display area covered by a layer as changed
+Vars: index of the layer
+------------------------------*/
+void DogGraphicDisplay::mark_layer(byte layer)
+{
+  DogCanvas *source = layers[layer].canvas;
+
+  for(int page = 0; page < source->pages; page++)
+    mark_dirty(layers[layer].upperLeftX, layers[layer].upperLeftX + source->sizeX - 1, layers[layer].upperLeftY + page);
+}
+
+/*----------------------------
+Func: flush_dirty
+Desc: sends all changed column spans of the canvas to the display
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::flush_dirty(void)
+{
+  byte start_column, end_column;
+
+  for(byte page = 0; page < DOG_MAX_PAGES; page++)  // RAM pages, with scrolling they are not the visible pages
+  {
+    if(scroll_span(page, dirtyStart, dirtyEnd, start_column, end_column))  // only pages with changes, mark_dirty keeps the span within canvas and display
+      flush_span(page, start_column, end_column);
+  }
+  clear_dirty();
+}
+
+/*----------------------------
+Func: flush_async_next
+Desc: starts the next page of flushCanvasAsync: sends the position and hands the data to the backend,
+      CS stays low until the backend has finished
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::flush_async_next(void)
+{
+  const byte *ptr;
+  byte start_column, end_column, len;
+
+  while(flushPage < DOG_MAX_PAGES && !scroll_span(flushPage, flushStart, flushEnd, start_column, end_column)) flushPage++;  // skip unchanged pages
+  if(flushPage >= DOG_MAX_PAGES)
+  {
+    flushActive = false;
+    if(bus != NULL && bus->active == this) bus->active = NULL;
+#if defined(DOG_STATS)
+    stats_flush(flushStartTime);
+#endif
+    return;
+  }
+
+  len = end_column - start_column + 1;
+  burst_select();
+  position(start_column, flushPage);
+  //scrolled RAM pages and layers are put together from several canvas pages, they can't be sent from the canvas
+  if(flushBackend != NULL && scrollLine == 0 && layerCount == 0 && flushPage >= flushUpperLeftY && flushPage < flushUpperLeftY + canvas.pages
+     && start_column >= flushUpperLeftX && end_column < flushUpperLeftX + canvas.sizeX)
+  {
+    ptr = &canvasFront[(flushPage - flushUpperLeftY) * canvas.sizeX + start_column - flushUpperLeftX];
+    if(shadow != NULL && flushPage < page_cnt())
+      memcpy(&shadow[flushPage * display_width() + start_column], ptr, len);
+
+    burst_flush();
+    a0_out(HIGH);
+#if defined(DOG_STATS)
+    stats.dataBytes += len;
+#endif
+    flushBackend->startTransfer(ptr, len);
+  }
+  else
+  {
+    for(byte x = start_column; x <= end_column; x++)
+      burst_data(canvas_byte(canvasFront, flushUpperLeftX, flushUpperLeftY, x, flushPage));
+    burst_flush();
+  }
+  flushPage++;
+}
+
+#if defined(DOG_STATS)
+/*----------------------------
+Func: stats_flush
+Desc: counts a finished flush with its time in min, max, average and histogram
+Vars: micros at the start of the flush
+------------------------------*/
+void DogGraphicDisplay::stats_flush(unsigned long start)
+{
+  unsigned long time = micros() - start;
+  byte bar = 0;
+
+  stats.flushes++;
+  flushTimeSum += time;
+  if(stats.flushes == 1 || time < stats.flushTimeMin) stats.flushTimeMin = time;
+  if(time > stats.flushTimeMax) stats.flushTimeMax = time;
+  while(bar < DOG_STATS_BUCKETS - 1 && time >= ((unsigned long)DOG_STATS_BUCKET_TIME << bar)) bar++;
+  stats.flushHistogram[bar]++;
+}
+#endif
+
+/*----------------------------
+Func: flush_span
+Desc: sends a column span of a display RAM page from the canvas. With shadow RAM only runs of changed bytes are sent,
+      runs separated by short gaps are merged because a new position costs 3 command bytes
+Vars: RAM page, start and end column (display coordinates, inside canvas)
+------------------------------*/
+void DogGraphicDisplay::flush_span(byte page, byte start_column, byte end_column)
+{
+  const byte *mirror = NULL;
+  int column = start_column;
+  int run_end;
+
+  if(shadow != NULL && page < page_cnt()) mirror = &shadow[page * display_width()];
+
+  while(column <= end_column)
+  {
+    run_end = end_column;
+    if(mirror != NULL)
+    {
+      while(column <= end_column && canvas_byte(canvas.buffer, canvasUpperLeftX, canvasUpperLeftY, column, page) == mirror[column]) column++;  // skip unchanged bytes
+      if(column > end_column) break;
+
+      run_end = column;
+      for(int x = column + 1; x <= end_column && x - run_end <= SHADOW_MERGE_GAP; x++)
+      {
+        if(canvas_byte(canvas.buffer, canvasUpperLeftX, canvasUpperLeftY, x, page) != mirror[x]) run_end = x;
+      }
+    }
+
+    burst_start();
+    position(column, page);
+
+    for( ; column <= run_end; column++)
+      burst_data(canvas_byte(canvas.buffer, canvasUpperLeftX, canvasUpperLeftY, column, page));
+
+    burst_stop();
+  }
+}
+
+/*----------------------------
+Func: canvas_byte
+Desc: returns the byte of a display RAM page that shows the canvas and the layers on top of it
+Vars: canvas buffer, upper left corner of the canvas (column, page), column (display coordinates, inside area), RAM page
+------------------------------*/
+byte DogGraphicDisplay::canvas_byte(const byte *buffer, int upper_left_x, int upper_left_y, byte column, byte page)
+{
+  byte mask, value;
+  byte result = layer_byte(buffer, canvas.sizeX, canvas.pages, upper_left_x, upper_left_y, column, page, mask);  //rows outside the canvas are 0
+
+  for(byte i = 0; i < layerCount; i++)  //bottom layer first
+  {
+    DogCanvas *layer = layers[i].canvas;
+    value = layer_byte(layer->buffer, layer->sizeX, layer->pages, layers[i].upperLeftX, layers[i].upperLeftY, column, page, mask);
+    if(mask) result = DogCanvas::rop_byte(result, value, mask, layers[i].rop);  //only the rows covered by the layer
+  }
+  return result;
+}
+
+/*----------------------------
+Func: layer_byte
+Desc: returns the byte of a display RAM page that shows a canvas. With scrolling the RAM page holds the lower rows of one
+      visible page and the upper rows of the next, visible rows outside the canvas are 0.
+Vars: canvas buffer and size, upper left corner of the canvas (column, page), column (display coordinates), RAM page,
+      returns the rows inside the canvas in mask
+------------------------------*/
+byte DogGraphicDisplay::layer_byte(const byte *buffer, byte size_x, byte pages, int upper_left_x, int upper_left_y, byte column, byte page, byte &mask)
+{
+  byte visible, shift = scrollLine & 7;
+  byte low = 0, high = 0, low_mask = 0, high_mask = 0;
+
+  mask = 0;
+  if(column < upper_left_x || column >= upper_left_x + size_x) return 0;
+  buffer += column - upper_left_x;
+
+  visible = (page - (scrollLine >> 3)) & (DOG_MAX_PAGES - 1);  //visible page with the lower rows of the RAM page
+  if(visible >= upper_left_y && visible < upper_left_y + pages && visible < page_cnt())
+  {
+    low = buffer[(visible - upper_left_y) * size_x];
+    low_mask = 0xFF;
+  }
+  if(shift == 0)
+  {
+    mask = low_mask;
+    return low;
+  }
+
+  visible = (visible - 1) & (DOG_MAX_PAGES - 1);  //visible page with the upper rows, wraps around like the display RAM
+  if(visible >= upper_left_y && visible < upper_left_y + pages && visible < page_cnt())
+  {
+    high = buffer[(visible - upper_left_y) * size_x];
+    high_mask = 0xFF;
+  }
+  mask = (low_mask << shift) | (high_mask >> (8 - shift));
+  return (low << shift) | (high >> (8 - shift));
+}
+
+/*----------------------------
+Func: scroll_span
+Desc: returns the column span of a display RAM page that has to be sent for the changed spans of the visible pages.
+      Without scrolling RAM page and visible page are the same, else a RAM page holds rows of one or two visible pages.
+Vars: RAM page, changed spans per visible page (start > end means unchanged), returns start and end column,
+      returns false if the RAM page is unchanged
+------------------------------*/
+bool DogGraphicDisplay::scroll_span(byte page, const byte *start, const byte *end, byte &start_column, byte &end_column)
+{
+  byte visible = (page - (scrollLine >> 3)) & (DOG_MAX_PAGES - 1);
+
+  start_column = start[visible];
+  end_column = end[visible];
+  if(scrollLine & 7)  //upper rows of the RAM page belong to the visible page above
+  {
+    visible = (visible - 1) & (DOG_MAX_PAGES - 1);
+    if(start[visible] < start_column) start_column = start[visible];
+    if(end[visible] > end_column) end_column = end[visible];
+  }
+  return start_column <= end_column;
+}
+
+/*----------------------------
+Func: canvas_scroll
+Desc: moves the content of the canvas like the display content is moved by scrolling. The rows that move into the canvas are
+      cleared and marked as changed, changes that were not sent yet move with the content.
+Vars: rows (positive = content moves up)
+------------------------------*/
+void DogGraphicDisplay::canvas_scroll(int dy)
+{
+  int step = dy >> 3;  //arithmetic shift, also for negative dy
+  byte shift = dy & 7;
+  int page, source, row;
+  byte column, low, high;
+  byte start[DOG_MAX_PAGES], end[DOG_MAX_PAGES];
+
+  for(byte i = 0; i < canvas.pages; i++)
+  {
+    page = (step >= 0) ? i : canvas.pages - 1 - i;  //read pages before they are overwritten
+    source = page + step;
+    for(column = 0; column < canvas.sizeX; column++)
+    {
+      low = (source >= 0 && source < canvas.pages) ? canvas.buffer[source * canvas.sizeX + column] : 0;
+      high = (source + 1 >= 0 && source + 1 < canvas.pages) ? canvas.buffer[(source + 1) * canvas.sizeX + column] : 0;
+      canvas.buffer[page * canvas.sizeX + column] = shift ? (low >> shift) | (high << (8 - shift)) : low;
+    }
+  }
+
+  memcpy(start, dirtyStart, sizeof(start));
+  memcpy(end, dirtyEnd, sizeof(end));
+  for(page = 0; page < DOG_MAX_PAGES; page++)  //unsent changes move with the content
+  {
+    if(start[page] > end[page]) continue;
+    row = (page - canvasUpperLeftY) * 8 - dy;
+    for(source = row >> 3; source <= (row + 7) >> 3; source++)
+      mark_dirty(start[page], end[page], source + canvasUpperLeftY);
+  }
+
+  if(dy > 0)
+  {
+    scrollY0 = canvas.sizeY - dy;
+    scrollY1 = canvas.sizeY - 1;
+  }
+  else
+  {
+    scrollY0 = 0;
+    scrollY1 = -dy - 1;
+  }
+  if(scrollY0 < 0) scrollY0 = 0;
+  if(scrollY1 >= canvas.sizeY) scrollY1 = canvas.sizeY - 1;
+  for(page = scrollY0 >> 3; page <= (scrollY1 >> 3); page++)
+    mark_dirty(canvasUpperLeftX, canvasUpperLeftX + canvas.sizeX - 1, page + canvasUpperLeftY);
+
+  for(byte i = 0; i < layerCount; i++)  //layers stay in place, the rows their content moved to are sent again
+  {
+    mark_layer(i);
+    row = layers[i].upperLeftY * 8 - dy;
+    for(source = row >> 3; source <= (row + layers[i].canvas->pages * 8 - 1) >> 3; source++)
+      mark_dirty(layers[i].upperLeftX, layers[i].upperLeftX + layers[i].canvas->sizeX - 1, source);
+  }
+  if(layerCount == 0) return;  //without layers the canvas covers the whole area
+
+  //the area between canvas and layers shows 0: send the rows the canvas content moved to and the rows that moved in at the area edge
+  row = (dy > 0) ? canvasUpperLeftY * 8 - dy : (canvasUpperLeftY + canvas.pages) * 8;
+  for(source = row >> 3; source <= (row + abs(dy) - 1) >> 3; source++)
+    mark_dirty(canvasUpperLeftX, canvasUpperLeftX + canvas.sizeX - 1, source);
+  if(dy > 0)
+    row = ((areaPage1 < page_cnt()) ? areaPage1 + 1 : page_cnt()) * 8 - dy;  //area edge inside the display
+  else
+    row = (areaPage0 > 0) ? areaPage0 * 8 : 0;
+  for(source = row >> 3; source <= (row + abs(dy) - 1) >> 3; source++)
+    mark_dirty(areaX0, areaX1, source);
+}
+
+/*----------------------------
+Func: mark_dirty
+Desc: marks a column span of a display page as changed, the span is limited to the area covered by the canvas and the layers
+Vars: start and end column (display coordinates), page
+------------------------------*/
+void DogGraphicDisplay::mark_dirty(int start_column, int end_column, int page)
+{
+  if(page < 0 || page >= page_cnt()) return;
+  if(page < areaPage0 || page > areaPage1) return;  // also without canvas and layers
+
+  if(start_column < areaX0) start_column = areaX0;  // stay inside area
+  if(end_column > areaX1) end_column = areaX1;
+  if(start_column < 0) start_column = 0;  // stay inside display
+  if(end_column >= display_width()) end_column = display_width() - 1;
+  if(start_column > end_column) return;
+
+  if(start_column < dirtyStart[page]) dirtyStart[page] = start_column;
+  if(end_column > dirtyEnd[page]) dirtyEnd[page] = end_column;
+}
+
+/*----------------------------
+Func: mark_ram_dirty
+Desc: marks the visible pages as changed that show a display RAM page, used by the page functions that write RAM pages directly.
+      While scrolled the RAM page holds rows of one or two visible pages (see layer_byte).
+Vars: start and end column (display coordinates), RAM page
+------------------------------*/
+void DogGraphicDisplay::mark_ram_dirty(int start_column, int end_column, byte page)
+{
+  byte visible = (page - (scrollLine >> 3)) & (DOG_MAX_PAGES - 1);  //visible page with the lower rows of the RAM page
+
+  mark_dirty(start_column, end_column, visible);
+  if(scrollLine & 7)  //upper rows of the RAM page belong to the visible page above
+    mark_dirty(start_column, end_column, (visible - 1) & (DOG_MAX_PAGES - 1));
+}
+
+/*----------------------------
+Func: clear_dirty
+Desc: marks all display pages as unchanged
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::clear_dirty(void)
+{
+  for(int page = 0; page < DOG_MAX_PAGES; page++)
+  {
+    dirtyStart[page] = 0xFF;
+    dirtyEnd[page] = 0;
+  }
+}
+
+/*----------------------------
+Func: position
+Desc: sets write pointer in DOG-Display, has to be called inside a burst
+Vars: column (0..127/131), page(0..3/7)
+------------------------------*/
+void DogGraphicDisplay::position(byte column, byte page)
+{
+  shadowColumn = column;  // keep track of the write pointer for the copy of the display RAM
+  shadowPage = page;
+
+  column += columnOffset;  // only used in top view
+#if defined(DOG_STATS)
+  stats.positions++;
+#endif
+
+  burst_command(0x10 + (column>>4)); //MSB address column
+  burst_command(0x00 + (column&0x0F)); //LSB address column
+  burst_command(0xB0 + (page&0x0F)); //address page
+}
+
+/*----------------------------
+Func: command
+Desc: Sends a command to the DOG-Display
+Vars: data
+------------------------------*/
+void DogGraphicDisplay::command(byte dat)
+{
+  burst_start();
+  burst_command(dat);
+  burst_stop();
+}
+
+/*----------------------------
+Func: data
+Desc: Sends data to the DOG-Display
+Vars: data
+------------------------------*/
+void DogGraphicDisplay::data(byte dat)
+{
+  burst_start();
+  burst_data(dat);
+  burst_stop();
+}
+
+/*----------------------------
+Func: burst_start
+Desc: Starts a burst, selects the display with CS. Command and data bytes are collected in the burst buffer
+      and sent as a block, A0 only changes at the boundary between command and data bytes
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::burst_start(void)
+{
+  if(flushActive) waitFlush();  // bus is used by flushCanvasAsync
+  if(bus != NULL) bus->acquire(this);  // or by another display on the bus
+  burst_select();
+}
+
+/*----------------------------
+Func: burst_select
+Desc: Starts a burst without waiting for flushCanvasAsync
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::burst_select(void)
+{
+  if(hardware && (bus == NULL || !bus->transaction))  // other devices on the bus can be used between bursts
+    spi_port->beginTransaction(spiSettings);
+  burstLen = 0;
+  burstA0 = 0xFF;  // A0 is set with the first byte
+  cs_out(LOW);
+}
+
+/*----------------------------
+Func: burst_command
+Desc: Adds a command byte to the burst
+Vars: data
+------------------------------*/
+void DogGraphicDisplay::burst_command(byte dat)
+{
+  if(burstA0 != LOW)
+  {
+    burst_flush();
+    a0_out(LOW);
+    burstA0 = LOW;
+  }
+  burstBuffer[burstLen++] = dat;
+  if(burstLen >= BURST_SIZE) burst_flush();
+}
+
+/*----------------------------
+Func: burst_data
+Desc: Adds a data byte for the display RAM to the burst. Updates the copy of the display RAM.
+Vars: data
+------------------------------*/
+void DogGraphicDisplay::burst_data(byte dat)
+{
+  if(burstA0 != HIGH)
+  {
+    burst_flush();
+    a0_out(HIGH);
+    burstA0 = HIGH;
+  }
+  if(shadow != NULL && shadowColumn < display_width() && shadowPage < page_cnt())
+    shadow[shadowPage * display_width() + shadowColumn] = dat;
+  shadowColumn++;  // display increments its column address after every data byte
+
+  burstBuffer[burstLen++] = dat;
+  if(burstLen >= BURST_SIZE) burst_flush();
+}
+
+/*----------------------------
+Func: burst_flush
+Desc: Sends the collected bytes of the burst as one block
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::burst_flush(void)
+{
+  if(burstLen == 0) return;
+#if defined(DOG_STATS)
+  if(burstA0 == HIGH) stats.dataBytes += burstLen;  // counted per block, not in spi_out
+  else stats.commandBytes += burstLen;
+#endif
+  if(hardware)
+    spi_port->transfer(burstBuffer, burstLen);  // received bytes overwrite the buffer, it is not needed any more
+  else
+  {
+    for(byte i = 0; i < burstLen; i++)
+      spi_out(burstBuffer[i]);
+  }
+  burstLen = 0;
+}
+
+/*----------------------------
+Func: burst_stop
+Desc: Sends the rest of the burst, deselects the display and ends the transaction. While DogSpiBus::flush holds the
+      transaction for the queued displays, the display stays selected.
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::burst_stop(void)
+{
+  burst_flush();
+  if(!burstHeld) cs_out(HIGH);
+  if(hardware && (bus == NULL || !bus->transaction)) spi_port->endTransaction();
+}
+
+/*----------------------------
+Func: spi_initialize
+Desc: Initializes SPI Hardware/Software
+Vars: CS-Pin, MOSI-Pin, SCK-Pin (MOSI=SCK Hardware else Software)
+------------------------------*/
+void DogGraphicDisplay::spi_initialize(byte cs, byte si, byte clk)
+{
+  //Set pin Configuration
+  p_cs = cs;
+
+  if(si == clk)
+  {
+    hardware = true;
+    p_si = MOSI;
+    p_clk = SCK;
+    DogGraphicDisplay::spi_port = &SPI;
+  }
   else
   {
     hardware = false;
@@ -894,10 +1948,8 @@ void DogGraphicDisplay::spi_initialize(byte cs, byte si, byte clk)
   digitalWrite(p_clk, HIGH);
   pinMode(p_clk, OUTPUT);
   if(hardware)
-  {
-    SPI.begin();
-    SPI.beginTransaction(SPISettings(10*1000*1000, MSBFIRST, SPI_MODE3)); /* SPI CLK = 10 MHz */
-  }
+    SPI.begin();  // every burst has its own transaction
+  pins_resolve();
 }
 
 /*----------------------------
@@ -916,36 +1968,25 @@ void DogGraphicDisplay::spi_initialize_h(SPIClass *port, byte cs)
   digitalWrite(p_cs, HIGH);
   pinMode(p_cs, OUTPUT);
 
-  spi_port->begin();
-  spi_port->beginTransaction(SPISettings(10*1000*1000, MSBFIRST, SPI_MODE3)); /* SPI CLK = 10 MHz */
-}
-
-/*----------------------------
-Func: spi_put_byte
-Desc: Sends one Byte using CS
-Vars: data
-------------------------------*/
-void DogGraphicDisplay::spi_put_byte(byte dat)
-{
-  digitalWrite(p_cs, LOW);
-  spi_out(dat);
-  digitalWrite(p_cs, HIGH);
+  if(bus == NULL)  // a shared bus starts the port itself, every burst has its own transaction
+    spi_port->begin();
+  pins_resolve();
 }
 
 /*----------------------------
 Func: spi_put
-Desc: Sends bytes using CS
+Desc: Sends command bytes using CS
 Vars: ptr to data and len
 ------------------------------*/
 void DogGraphicDisplay::spi_put(byte *dat, int len)
 {
-  digitalWrite(p_cs, LOW);
+  burst_start();
   do
   {
-    spi_out(*dat++);
+    burst_command(*dat++);
   }while(--len);
 
-  digitalWrite(p_cs, HIGH);
+  burst_stop();
 }
 
 /*----------------------------
@@ -955,13 +1996,25 @@ Vars: data
 ------------------------------*/
 void DogGraphicDisplay::spi_out(byte dat)
 {
-  byte i = 8;
   if(hardware)
   {
     spi_port->transfer(dat);
   }
   else
   {
+#if defined(DOG_FAST_PINS)
+    DOG_PINS_LOCK();  // once for the byte
+    DOG_FAST_BIT(0x80);
+    DOG_FAST_BIT(0x40);
+    DOG_FAST_BIT(0x20);
+    DOG_FAST_BIT(0x10);
+    DOG_FAST_BIT(0x08);
+    DOG_FAST_BIT(0x04);
+    DOG_FAST_BIT(0x02);
+    DOG_FAST_BIT(0x01);
+    DOG_PINS_UNLOCK();
+#else
+    byte i = 8;
     do
     {
       if(dat & 0x80)
@@ -972,5 +2025,64 @@ void DogGraphicDisplay::spi_out(byte dat)
       dat <<= 1;
       digitalWrite(p_clk, HIGH);
     }while(--i);
+#endif
+  }
+}
+
+/*----------------------------
+Func: pins_resolve
+Desc: Looks up output register and bit mask of the SPI pins once, so they can be switched without digitalWrite
+Vars: none
+------------------------------*/
+void DogGraphicDisplay::pins_resolve(void)
+{
+#if defined(DOG_FAST_PINS)
+  port_cs = portOutputRegister(digitalPinToPort(p_cs));
+  mask_cs = digitalPinToBitMask(p_cs);
+  port_a0 = portOutputRegister(digitalPinToPort(p_a0));
+  mask_a0 = digitalPinToBitMask(p_a0);
+  if(!hardware)
+  {
+    port_si = portOutputRegister(digitalPinToPort(p_si));
+    mask_si = digitalPinToBitMask(p_si);
+    port_clk = portOutputRegister(digitalPinToPort(p_clk));
+    mask_clk = digitalPinToBitMask(p_clk);
   }
+#endif
+}
+
+/*----------------------------
+Func: cs_out
+Desc: Sets the CS pin
+Vars: level (HIGH, LOW)
+------------------------------*/
+void DogGraphicDisplay::cs_out(byte level)
+{
+#if defined(DOG_FAST_PINS)
+  DOG_PINS_LOCK();
+  if(level == LOW) DOG_PIN_LOW(port_cs, mask_cs);
+  else DOG_PIN_HIGH(port_cs, mask_cs);
+  DOG_PINS_UNLOCK();
+#else
+  digitalWrite(p_cs, level);
+#endif
+  if(mirror != NULL) mirror->cs_out(level);  // broadcast
+}
+
+/*----------------------------
+Func: a0_out
+Desc: Sets the A0 pin (high=data, low=command)
+Vars: level (HIGH, LOW)
+------------------------------*/
+void DogGraphicDisplay::a0_out(byte level)
+{
+#if defined(DOG_FAST_PINS)
+  DOG_PINS_LOCK();
+  if(level == LOW) DOG_PIN_LOW(port_a0, mask_a0);
+  else DOG_PIN_HIGH(port_a0, mask_a0);
+  DOG_PINS_UNLOCK();
+#else
+  digitalWrite(p_a0, level);
+#endif
+  if(mirror != NULL) mirror->a0_out(level);
 }
@@ -17,24 +17,89 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include "DogCanvas.h"
+#include "DogSprite.h"
+#include "DogSpiBus.h"
+#include "DogAnimation.h"
+
+// direct port register access for bit bang SPI, CS and A0 on cores that provide the macros
+#if defined(portOutputRegister) && defined(digitalPinToBitMask) && defined(digitalPinToPort)
+#if defined(ARDUINO_ARCH_AVR)
+#define DOG_FAST_PINS
+typedef volatile uint8_t dog_port_t;
+typedef uint8_t dog_mask_t;
+#elif defined(ARDUINO_ARCH_SAMD)
+#define DOG_FAST_PINS
+typedef volatile uint32_t dog_port_t;
+typedef uint32_t dog_mask_t;
+#endif
+#endif
 
 #define DOGM128 1
 #define DOGL128 2
 #define DOGM132 3
 #define DOGS102 4
 
-#define ALIGN_LEFT 1
-#define ALIGN_RIGHT 2
-#define ALIGN_CENTER 3
-
-#define STYLE_NORMAL 1
-#define STYLE_FULL 2
-#define STYLE_INVERSE 3
-#define STYLE_FULL_INVERSE 4
-
 #define VIEW_BOTTOM 0xC0
 #define VIEW_TOP 0xC8
 
+// define DOG_NO_HEAP in the build flags to remove all functions that allocate memory,
+// canvas and shadow RAM then have to be provided by the caller
+// define DOG_STATS in the build flags for the counters of getStats, without it nothing is counted
+
+#define CANVAS_DIRECT 0
+#define CANVAS_BUFFERED 1
+#define CANVAS_DOUBLE_BUFFERED 2
+
+#define DOG_MAX_PAGES 8  // highest page count of all supported displays
+#define DOG_MAX_LAYERS 4  // count of canvases that can be added with addLayer
+#define SHADOW_MERGE_GAP 3  // unchanged bytes sent instead of a new position (3 command bytes)
+#define BURST_SIZE 32  // size of the buffer for block transfers
+#define DOG_SPI_CLOCK 10000000  // default SPI clock of hardware SPI, see begin with SPISettings
+
+/*
+ * Interface for a transfer that sends data in the background (e.g. DMA), used by flushCanvasAsync.
+ * CS is low and A0 is high when startTransfer is called.
+ */
+class DogFlushBackend
+{
+  public:
+    virtual ~DogFlushBackend () {}
+    virtual void startTransfer (const byte *dat, unsigned int len) = 0;
+    virtual bool isBusy (void) = 0;
+};
+
+#if defined(DOG_STATS)
+#define DOG_STATS_BUCKETS 8  // bars of the flush time histogram
+#define DOG_STATS_BUCKET_TIME 1000  // upper limit of the first bar in microseconds, doubled for every next bar
+
+/*
+ * Counters of a display since the last resetStats, see DogGraphicDisplay::getStats.
+ * Bar i of the histogram counts the flushes shorter than DOG_STATS_BUCKET_TIME << i, the last bar all longer ones.
+ */
+struct DogStats
+{
+  unsigned long dataBytes;  // bytes for the display RAM
+  unsigned long commandBytes;
+  unsigned long positions;  // column and page set
+  unsigned long flushes;  // flushCanvas and finished flushCanvasAsync
+  unsigned long pixels;  // written into the canvas of createCanvas
+  unsigned long flushTimeMin, flushTimeAvg, flushTimeMax;  // microseconds
+  unsigned int flushHistogram[DOG_STATS_BUCKETS];
+};
+#endif
+
+/*
+ * Memory for a canvas with a size known at compile time, so no heap is needed.
+ * Use FRAMES = 2 for CANVAS_DOUBLE_BUFFERED.
+ */
+template <byte W, byte H, byte FRAMES = 1>
+class DogStaticCanvas
+{
+  public:
+    byte buffer[W * ((H + 7) / 8) * FRAMES];
+};
+
 class DogGraphicDisplay
 {
   public:
@@ -42,6 +107,10 @@ class DogGraphicDisplay
     ~DogGraphicDisplay ();
     void begin (byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type);
     void begin (SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type);
+    void begin (DogSpiBus &bus, byte p_cs, byte p_a0, byte p_res, byte type);
+    void begin (byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type, SPISettings settings);
+    void begin (SPIClass *port, byte p_cs, byte p_a0, byte p_res, byte type, SPISettings settings);
+    void begin (DogSpiBus &bus, byte p_cs, byte p_a0, byte p_res, byte type, SPISettings settings);
     void end ();
     void initialize (byte p_cs, byte p_si, byte p_clk, byte p_a0, byte p_res, byte type);
     void clear (void);
@@ -56,20 +125,79 @@ class DogGraphicDisplay
     void rectangle (byte start_column, byte start_page, byte end_column, byte end_page, byte pattern);
     void picture (byte column, byte page, const byte *pic_adress);
     void picture (byte column, byte page, const byte *pic_adress, byte style);
+    void string (int column, byte page, DogAsset &font, const char *str);
+    void string (int column, byte page, DogAsset &font, const char *str, byte align);
+    void string (int column, byte page, DogAsset &font, const char *str, byte align, byte style);
+    void picture (byte column, byte page, DogAsset &pic);
+    void picture (byte column, byte page, DogAsset &pic, byte style);
     byte display_width (void);
     byte page_cnt (void);
+#if !defined(DOG_NO_HEAP)
     void createCanvas(byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY);
     void createCanvas(byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY, byte drawMode);
+#endif
+    void createCanvas(byte *buffer, byte canvasSizeX, byte canvasSizeY, int upperLeftX, int upperLeftY, byte drawMode);
+    template <byte W, byte H, byte FRAMES>
+    void createCanvas(DogStaticCanvas<W, H, FRAMES> &memory, int upperLeftX, int upperLeftY, byte drawMode)
+    {
+      createCanvas(memory.buffer, W, H, upperLeftX, upperLeftY, drawMode);
+    }
+    static unsigned int canvasBytes(byte canvasSizeX, byte canvasSizeY);
     void deleteCanvas();
+    DogCanvas &getCanvas();
     void setPixel(int x, int y, bool value);
     void drawLine(int x0, int y0, int x1, int y1);
     void drawArrow(int x0, int y0, int x1, int y1);
     void drawCircle(int x0, int y0, int r, bool fill);
     void drawRect(int x0, int y0, int width, int height, bool fill);
     void drawCross(int x0, int y0, int width, int height);
+    void drawString(int x, int y, const byte *font_adress, const char *str);
+    void drawString(int x, int y, const byte *font_adress, const char *str, byte style);
+    void blit(int x, int y, const byte *pic_adress, byte rop);
+    void blit(int x, int y, const byte *pic_adress, const byte *mask_adress, byte rop);
+    int textWidth(const byte *font_adress, const char *str);
+    int textHeight(const byte *font_adress);
+    int textHeight(const byte *font_adress, const char *str, int width);
+    void drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align);
+    void drawTextBox(int x, int y, int width, int height, const byte *font_adress, const char *str, byte align, byte style);
+    void drawString(int x, int y, DogAsset &font, const char *str);
+    void drawString(int x, int y, DogAsset &font, const char *str, byte style);
+    void blit(int x, int y, DogAsset &pic, byte rop);
+    void blit(int x, int y, DogAsset &pic, DogAsset &mask, byte rop);
+    int textWidth(DogAsset &font, const char *str);
+    int textHeight(DogAsset &font);
+    int textHeight(DogAsset &font, const char *str, int width);
+    void drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align);
+    void drawTextBox(int x, int y, int width, int height, DogAsset &font, const char *str, byte align, byte style);
+    bool pushClip(int x, int y, int width, int height);
+    void popClip(void);
     void clearCanvas(void);
     void flushCanvas(int upperLeftX, int upperLeftY);
     void flushCanvas(void);
+    void flushCanvasAsync(void);
+    bool isFlushBusy(void);
+    void waitFlush(void);
+    void setFlushBackend(DogFlushBackend *backend);
+#if !defined(DOG_NO_HEAP)
+    void enableShadow(bool state);
+#endif
+    void enableShadow(byte *buffer);
+    bool addLayer(DogCanvas &layer, int upperLeftX, int upperLeftY, byte rop);
+    void moveLayer(DogCanvas &layer, int upperLeftX, int upperLeftY);
+    void removeLayer(DogCanvas &layer);
+    void invalidateCanvas(void);
+    bool getDirtyArea(int &x0, int &y0, int &x1, int &y1);
+    unsigned int dirtyBytes(void);
+    void setGlyphCache(DogGlyphCache *cache);
+    void scrollTo(byte line);
+    void scrollBy(int dy);
+    byte getScroll(void);
+    bool getScrollArea(int &y0, int &y1);
+    byte scrollPage(byte page);
+#if defined(DOG_STATS)
+    DogStats getStats(void);
+    void resetStats(void);
+#endif
 
   private:
     byte p_cs;
@@ -79,23 +207,98 @@ class DogGraphicDisplay
     byte type;
     boolean hardware;
     boolean top_view;
+    byte columnTotal, pageTotal, columnOffset;  // geometry of the display type, set by panel_setup
     SPIClass *spi_port;
+    SPISettings spiSettings;  // used for the transaction of every burst
+    DogSpiBus *bus;  // NULL if the display uses the SPI port alone
+    DogGraphicDisplay *mirror;  // next display of a broadcast, gets the same CS and A0 levels
+    DogGraphicDisplay *mirrorOf;  // source of the broadcast if this display is a mirror
 
-    byte *canvas;
+    DogCanvas canvas;  // canvas of createCanvas, no memory if there is none
 
     byte drawMode;
-    byte canvasSizeX, canvasSizeY, canvasPages;
     int canvasUpperLeftX, canvasUpperLeftY;
+    byte dirtyStart[DOG_MAX_PAGES], dirtyEnd[DOG_MAX_PAGES];  // changed columns per display page, start > end means clean
+
+    bool canvasOwned;  // canvas memory was allocated by createCanvas
+    byte *canvasFront;  // second buffer of a double buffered canvas, sent by flushCanvasAsync
+    DogFlushBackend *flushBackend;
+    bool flushActive;
+    byte flushPage;
+    byte flushStart[DOG_MAX_PAGES], flushEnd[DOG_MAX_PAGES];  // column spans sent by flushCanvasAsync
+    int flushUpperLeftX, flushUpperLeftY;
+
+    void flush_async_next (void);
+
+#if defined(DOG_STATS)
+    DogStats stats;
+    unsigned long flushTimeSum;
+    unsigned long flushStartTime;  // of the running flushCanvasAsync
 
+    void stats_flush (unsigned long start);
+#endif
+
+    byte *shadow;  // copy of the display RAM, NULL if disabled
+    bool shadowOwned;
+    byte shadowColumn, shadowPage;
+
+    byte scrollLine;  // display start line, RAM row shown in the top row of the display
+    int scrollY0, scrollY1;  // canvas rows cleared by the last scrollBy
+
+    struct
+    {
+      DogCanvas *canvas;
+      int upperLeftX, upperLeftY;  // column and page
+      byte rop;  // combines the layer with the canvas and the layers below
+    } layers[DOG_MAX_LAYERS];  // bottom layer first
+    byte layerCount;
+    int areaX0, areaX1, areaPage0, areaPage1;  // display area covered by canvas and layers, empty if start > end
+
+    friend class DogCanvas;
+    friend class DogSpiBus;
+    friend class DogAnimation;
+    void canvas_changed (DogCanvas *source, int start_column, int end_column, int page);
+    void area_update (void);
+    void mark_layer (byte layer);
+    void flush_dirty (void);
+    void flush_span (byte page, byte start_column, byte end_column);
+    byte canvas_byte (const byte *buffer, int upper_left_x, int upper_left_y, byte column, byte page);
+    byte layer_byte (const byte *buffer, byte size_x, byte pages, int upper_left_x, int upper_left_y, byte column, byte page, byte &mask);
+    bool scroll_span (byte page, const byte *start, const byte *end, byte &start_column, byte &end_column);
+    void canvas_scroll (int dy);
+    void mark_dirty (int start_column, int end_column, int page);
+    void mark_ram_dirty (int start_column, int end_column, byte page);
+    void clear_dirty (void);
+
+    void panel_setup (byte type);
     void position (byte column, byte page);
     void command (byte dat);
     void data (byte dat);
 
+    byte burstBuffer[BURST_SIZE];
+    byte burstLen;
+    byte burstA0;  // current state of A0 inside the burst, 0xFF if not set yet
+    bool burstHeld;  // CS stays low between the bursts, set by DogSpiBus::flush
+
+    void burst_start (void);
+    void burst_select (void);
+    void burst_command (byte dat);
+    void burst_data (byte dat);
+    void burst_flush (void);
+    void burst_stop (void);
+
     void spi_initialize (byte cs, byte si, byte clk);
     void spi_initialize_h (SPIClass *port, byte cs);
-    void spi_put_byte (byte dat);
     void spi_put (byte *dat, int len);
     void spi_out (byte dat);
+
+#if defined(DOG_FAST_PINS)
+    dog_port_t *port_cs, *port_a0, *port_si, *port_clk;
+    dog_mask_t mask_cs, mask_a0, mask_si, mask_clk;
+#endif
+    void pins_resolve (void);
+    void cs_out (byte level);
+    void a0_out (byte level);
 };
 
 #endif /* DOGGRAPHICDISPLAY_H */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * SPI bus shared by several displays with their own CS and A0 pins.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "DogSpiBus.h"
+#include "DogGraphicDisplay.h"
+
+/*----------------------------
+Func: DogSpiBus
+Desc: constructor, the port is started by begin or by the first display
+Vars: SPI port
+------------------------------*/
+DogSpiBus::DogSpiBus(SPIClass *port)
+{
+  this->port = port;
+  started = false;
+  active = NULL;
+  queueCount = 0;
+  queueAsync = false;
+  transaction = false;
+}
+
+/*----------------------------
+Func: begin
+Desc: starts the SPI port, only the first call has an effect
+Vars: none
+------------------------------*/
+void DogSpiBus::begin(void)
+{
+  if(started) return;
+  port->begin();  // the displays use a transaction for every burst
+  started = true;
+}
+
+/*----------------------------
+Func: end
+Desc: stops the SPI port after all transfers have finished
+Vars: none
+------------------------------*/
+void DogSpiBus::end(void)
+{
+  if(!started) return;
+  waitIdle();
+  port->end();
+  started = false;
+}
+
+/*----------------------------
+Func: getPort
+Desc: returns the SPI port of the bus
+Vars: none
+------------------------------*/
+SPIClass *DogSpiBus::getPort(void)
+{
+  return port;
+}
+
+/*----------------------------
+Func: queueFlush
+Desc: adds a display to the displays that are flushed by the next flush or flushAsync, a display is queued only once
+Vars: display on this bus, returns false if DOG_BUS_QUEUE displays are queued already
+------------------------------*/
+bool DogSpiBus::queueFlush(DogGraphicDisplay &display)
+{
+  for(byte i = 0; i < queueCount; i++)
+  {
+    if(queue[i] == &display) return true;
+  }
+  if(queueCount >= DOG_BUS_QUEUE || display.bus != this) return false;
+  queue[queueCount++] = &display;
+  return true;
+}
+
+/*----------------------------
+Func: flush
+Desc: sends the changes of all queued displays back to back and empties the queue. One transaction with the SPI settings
+      of the first queued display is held for all of them, each display stays selected for all its pages: only CS and A0
+      change between the displays, the position is sent for every changed span.
+Vars: none
+------------------------------*/
+void DogSpiBus::flush(void)
+{
+  DogGraphicDisplay *display;
+
+  waitIdle();
+  if(queueCount == 0) return;
+
+  port->beginTransaction(queue[0]->spiSettings);
+  transaction = true;
+  for(byte i = 0; i < queueCount; i++)
+  {
+    display = queue[i];
+    display->burstHeld = true;
+    display->flushCanvas();
+    display->burstHeld = false;
+    display->cs_out(HIGH);
+  }
+  transaction = false;
+  port->endTransaction();
+  queueCount = 0;
+}
+
+/*----------------------------
+Func: flushAsync
+Desc: sends the queued displays one after the other with flushCanvasAsync. Call isBusy regularly, it starts the next display
+      when the last one has finished.
+Vars: none
+------------------------------*/
+void DogSpiBus::flushAsync(void)
+{
+  queueAsync = true;
+  isBusy();
+}
+
+/*----------------------------
+Func: isBusy
+Desc: returns true while a display on the bus sends with flushCanvasAsync or queued displays wait for flushAsync
+Vars: none
+------------------------------*/
+bool DogSpiBus::isBusy(void)
+{
+  DogGraphicDisplay *display;
+
+  while(active == NULL || !active->isFlushBusy())  // bus is free, start the next queued display
+  {
+    if(!queueAsync || queueCount == 0)
+    {
+      queueAsync = false;
+      return false;
+    }
+    display = queue[0];
+    queueCount--;
+    for(byte i = 0; i < queueCount; i++)
+      queue[i] = queue[i + 1];
+    display->flushCanvasAsync();  // without second buffer the display is sent at once
+  }
+  return true;
+}
+
+/*----------------------------
+Func: waitIdle
+Desc: waits until all transfers on the bus have finished
+Vars: none
+------------------------------*/
+void DogSpiBus::waitIdle(void)
+{
+  while(isBusy());
+}
+
+/*----------------------------
+Func: broadcast
+Desc: the mirror display gets everything the source display sends: CS and A0 of the mirror follow the source, so the data
+      is sent only once for all panels. Both panels are cleared to start with the same content. Do not draw on the mirror
+      until endBroadcast, it has to be a panel of the same type and view.
+Vars: source and mirror display on this bus, returns false if a display is used for another broadcast already
+------------------------------*/
+bool DogSpiBus::broadcast(DogGraphicDisplay &source, DogGraphicDisplay &mirror)
+{
+  DogGraphicDisplay *last = &source;
+
+  if(&source == &mirror || source.bus != this || mirror.bus != this) return false;
+  if(source.mirrorOf != NULL || mirror.mirrorOf != NULL || mirror.mirror != NULL) return false;
+  waitIdle();
+
+  while(last->mirror != NULL) last = last->mirror;  // append to the mirrors of the source
+  last->mirror = &mirror;
+  mirror.mirrorOf = &source;
+  source.clear();  // sent to all panels of the broadcast
+  return true;
+}
+
+/*----------------------------
+Func: endBroadcast
+Desc: removes a mirror from its broadcast, the mirror is cleared and can be used on its own again
+Vars: mirror display
+------------------------------*/
+void DogSpiBus::endBroadcast(DogGraphicDisplay &mirror)
+{
+  if(mirror.mirrorOf == NULL) return;
+  waitIdle();
+  remove(&mirror);
+  mirror.clear();
+}
+
+//----------------------------------------------------private Functions----------------------------------------------------
+
+/*----------------------------
+Func: acquire
+Desc: waits until the bus is free for a display, a flushCanvasAsync of another display is finished first
+Vars: display that wants to send
+------------------------------*/
+void DogSpiBus::acquire(DogGraphicDisplay *display)
+{
+  if(active != NULL && active != display) active->waitFlush();
+}
+
+/*----------------------------
+Func: remove
+Desc: removes a display from the queue and from broadcasts, called when a display ends or leaves a broadcast
+Vars: display
+------------------------------*/
+void DogSpiBus::remove(DogGraphicDisplay *display)
+{
+  DogGraphicDisplay *previous;
+
+  for(byte i = 0; i < queueCount; i++)
+  {
+    if(queue[i] != display) continue;
+    queueCount--;
+    for( ; i < queueCount; i++)
+      queue[i] = queue[i + 1];
+  }
+  if(active == display) active = NULL;
+
+  if(display->mirrorOf != NULL)  // mirror: unlink from the chain of its source
+  {
+    for(previous = display->mirrorOf; previous->mirror != display; previous = previous->mirror);
+    previous->mirror = display->mirror;
+    display->mirror = NULL;
+    display->mirrorOf = NULL;
+  }
+  while(display->mirror != NULL)  // source: release all mirrors
+  {
+    previous = display->mirror;
+    display->mirror = previous->mirror;
+    previous->mirror = NULL;
+    previous->mirrorOf = NULL;
+  }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * SPI bus shared by several displays with their own CS and A0 pins.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGSPIBUS_H
+#define DOGSPIBUS_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define DOG_BUS_QUEUE 4  // count of displays that can wait for a flush of the bus
+
+class DogGraphicDisplay;
+
+/*
+ * The bus starts the SPI port once for all displays (see DogGraphicDisplay::begin with bus), each display uses its own
+ * SPI settings for the transaction of every burst. A display waits with its
+ * transfers until the flushCanvasAsync of another display on the bus has finished.
+ * Flushes can be queued, flush sends them back to back in one transaction with the SPI settings of the first queued display,
+ * only CS and A0 change between the displays.
+ * Displays with CS lines wired together are one DogGraphicDisplay, with separate CS lines see broadcast.
+ * A0 can be shared, the RESET pins can't: begin resets its display, a shared RESET would reset the displays started before.
+ */
+class DogSpiBus
+{
+  public:
+    DogSpiBus (SPIClass *port);
+    void begin (void);
+    void end (void);
+    SPIClass *getPort (void);
+    bool queueFlush (DogGraphicDisplay &display);
+    void flush (void);
+    void flushAsync (void);
+    bool isBusy (void);
+    void waitIdle (void);
+    bool broadcast (DogGraphicDisplay &source, DogGraphicDisplay &mirror);
+    void endBroadcast (DogGraphicDisplay &mirror);
+
+  private:
+    friend class DogGraphicDisplay;
+
+    SPIClass *port;
+    bool started;
+    DogGraphicDisplay *active;  // display with a running flushCanvasAsync, NULL if the bus is free
+    DogGraphicDisplay *queue[DOG_BUS_QUEUE];
+    byte queueCount;
+    bool queueAsync;  // queue is sent by flushAsync, the next display starts when the active one has finished
+    bool transaction;  // flush holds one transaction for the queued displays
+
+    void acquire (DogGraphicDisplay *display);
+    void remove (DogGraphicDisplay *display);
+};
+
+#endif
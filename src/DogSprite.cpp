@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Sprite: picture with mask that moves over a canvas without redrawing the canvas.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#include <Arduino.h>
+#include "DogSprite.h"
+
+/*----------------------------
+Func: DogSprite
+Desc: constructor, the background is saved in memory provided by the caller
+Vars: picture and mask (BLH-pictures of the same size in program memory, mask NULL = set pixels of the picture),
+      buffer for the background (backgroundBytes(pic_adress) bytes)
+------------------------------*/
+DogSprite::DogSprite(const byte *pic_adress, const byte *mask_adress, byte *background)
+{
+  DogProgmemAsset pic(pic_adress);
+
+  picture = pic_adress;
+  mask = mask_adress;
+  this->background = background;
+  backgroundOwned = false;
+  width = DogCanvas::picture_width(pic);
+  height = DogCanvas::picture_height(pic);
+  canvas = NULL;
+  posX = 0;
+  posY = 0;
+  dirtyX0 = 0;
+  dirtyY0 = 0;
+  dirtyX1 = -1;
+  dirtyY1 = -1;
+}
+
+#if !defined(DOG_NO_HEAP)
+/*----------------------------
+Func: DogSprite
+Desc: constructor, allocates the memory for the background on the heap
+Vars: picture and mask (BLH-pictures of the same size in program memory, mask NULL = set pixels of the picture)
+------------------------------*/
+DogSprite::DogSprite(const byte *pic_adress, const byte *mask_adress) : DogSprite(pic_adress, mask_adress, new byte[backgroundBytes(pic_adress)])
+{
+  backgroundOwned = true;
+}
+#endif
+
+/*-----------------------------
+destructor, frees the memory if it was allocated by the constructor. The sprite stays on the canvas.
+*/
+DogSprite::~DogSprite()
+{
+#if !defined(DOG_NO_HEAP)
+  if(backgroundOwned)
+    delete[] background;
+#endif
+}
+
+/*----------------------------
+Func: backgroundBytes
+Desc: returns the memory needed to save the background of a sprite, one page more than the picture for unaligned positions
+Vars: picture in program memory
+------------------------------*/
+unsigned int DogSprite::backgroundBytes(const byte *pic_adress)
+{
+  DogProgmemAsset pic(pic_adress);
+
+  return DogCanvas::picture_width(pic) * ((DogCanvas::picture_height(pic) + 7) / 8 + 1);
+}
+
+/*----------------------------
+Func: show
+Desc: draws the sprite on a canvas, a sprite shown before is hidden first
+Vars: canvas, coordinates of upper left corner
+------------------------------*/
+void DogSprite::show(DogCanvas &canvas, int x, int y)
+{
+  hide();
+  this->canvas = &canvas;
+  posX = x;
+  posY = y;
+  save();
+  draw();
+  add_dirty();
+}
+
+/*----------------------------
+Func: moveTo
+Desc: moves the sprite, the background at the old position is restored. Only the old and the new position are marked as changed.
+Vars: coordinates of upper left corner
+------------------------------*/
+void DogSprite::moveTo(int x, int y)
+{
+  if(canvas == NULL)  // hidden, only the position changes
+  {
+    posX = x;
+    posY = y;
+    return;
+  }
+  if(x == posX && y == posY) return;
+
+  add_dirty();
+  restore();
+  posX = x;
+  posY = y;
+  save();
+  draw();
+  add_dirty();
+}
+
+/*----------------------------
+Func: moveBy
+Desc: moves the sprite relative to its position, see moveTo
+Vars: distance in x and y direction
+------------------------------*/
+void DogSprite::moveBy(int dx, int dy)
+{
+  moveTo(posX + dx, posY + dy);
+}
+
+/*----------------------------
+Func: hide
+Desc: removes the sprite from the canvas, the background is restored
+Vars: none
+------------------------------*/
+void DogSprite::hide(void)
+{
+  if(canvas == NULL) return;
+  add_dirty();
+  restore();
+  canvas = NULL;
+}
+
+/*----------------------------
+Func: isVisible
+Desc: returns true while the sprite is shown on a canvas
+Vars: none
+------------------------------*/
+bool DogSprite::isVisible(void)
+{
+  return canvas != NULL;
+}
+
+/*----------------------------
+Func: getX
+Desc: returns the x coordinate of the upper left corner
+Vars: none
+------------------------------*/
+int DogSprite::getX(void)
+{
+  return posX;
+}
+
+/*----------------------------
+Func: getY
+Desc: returns the y coordinate of the upper left corner
+Vars: none
+------------------------------*/
+int DogSprite::getY(void)
+{
+  return posY;
+}
+
+/*----------------------------
+Func: getDirtyArea
+Desc: returns the bounding box of all positions changed by show, moveTo and hide since the last call, the canvas has marked them
+      for the next flushCanvas already
+Vars: references for upper left and lower right corner in canvas coordinates, returns false if nothing changed
+------------------------------*/
+bool DogSprite::getDirtyArea(int &x0, int &y0, int &x1, int &y1)
+{
+  if(dirtyX0 > dirtyX1) return false;
+  x0 = dirtyX0;
+  y0 = dirtyY0;
+  x1 = dirtyX1;
+  y1 = dirtyY1;
+  dirtyX0 = 0;
+  dirtyX1 = -1;
+  return true;
+}
+
+//----------------------------------------------------private Functions----------------------------------------------------
+
+/*----------------------------
+Func: save
+Desc: copies the canvas bytes below the sprite into the background buffer
+Vars: none
+------------------------------*/
+void DogSprite::save(void)
+{
+  int page0 = posY >> 3;  //arithmetic shift, also for negative y
+  byte pages = ((posY & 7) + height + 7) >> 3;
+  int column_start = (posX < 0) ? -posX : 0;  //columns of the sprite inside the canvas
+  int column_end = (posX + width > canvas->sizeX) ? canvas->sizeX - posX - 1 : width - 1;
+
+  if(canvas->buffer == NULL) return;
+  for(byte row = 0; row < pages; row++)
+  {
+    if(page0 + row < 0 || page0 + row >= canvas->pages) continue;
+    for(int column = column_start; column <= column_end; column++)
+      background[row * width + column] = canvas->buffer[(page0 + row) * canvas->sizeX + posX + column];
+  }
+}
+
+/*----------------------------
+Func: restore
+Desc: writes the saved background back into the canvas and marks it as changed
+Vars: none
+------------------------------*/
+void DogSprite::restore(void)
+{
+  int page0 = posY >> 3;
+  byte pages = ((posY & 7) + height + 7) >> 3;
+  int column_start = (posX < 0) ? -posX : 0;
+  int column_end = (posX + width > canvas->sizeX) ? canvas->sizeX - posX - 1 : width - 1;
+
+  if(canvas->buffer == NULL || column_start > column_end) return;
+  for(byte row = 0; row < pages; row++)
+  {
+    if(page0 + row < 0 || page0 + row >= canvas->pages) continue;
+    for(int column = column_start; column <= column_end; column++)
+      canvas->buffer[(page0 + row) * canvas->sizeX + posX + column] = background[row * width + column];
+    canvas->changed(posX + column_start, posX + column_end, page0 + row);
+  }
+}
+
+/*----------------------------
+Func: draw
+Desc: draws the sprite at its position, only the pixels of the mask are changed
+Vars: none
+------------------------------*/
+void DogSprite::draw(void)
+{
+  if(mask == NULL) canvas->blit(posX, posY, picture, ROP_OR);  // set pixels are the mask
+  else canvas->blit(posX, posY, picture, mask, ROP_COPY);
+}
+
+/*----------------------------
+Func: add_dirty
+Desc: adds the current position to the dirty area
+Vars: none
+------------------------------*/
+void DogSprite::add_dirty(void)
+{
+  if(dirtyX0 > dirtyX1)
+  {
+    dirtyX0 = posX;
+    dirtyY0 = posY;
+    dirtyX1 = posX + width - 1;
+    dirtyY1 = posY + height - 1;
+    return;
+  }
+  if(posX < dirtyX0) dirtyX0 = posX;
+  if(posY < dirtyY0) dirtyY0 = posY;
+  if(posX + width - 1 > dirtyX1) dirtyX1 = posX + width - 1;
+  if(posY + height - 1 > dirtyY1) dirtyY1 = posY + height - 1;
+}
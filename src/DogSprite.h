@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 by generationmake bernhard@generationmake.de
+ * Arduino library for Electronic Assembly Dog Graphic Display DOGM132-5, DOGM128-6, DOGL128-6 and DOGS102-6 (controller ST7565 and UC1701)
+ *
+ * Sprite: picture with mask that moves over a canvas without redrawing the canvas.
+ *
+ * This file is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License version 2.1,
+ * as published by the Free Software Foundation.
+ */
+
+#ifndef DOGSPRITE_H
+#define DOGSPRITE_H
+
+#include <Arduino.h>
+#include "DogCanvas.h"
+
+/*
+ * The canvas bytes below the sprite are saved when it is drawn and written back when it moves or is hidden,
+ * so only the old and the new position are changed and sent. Draw on the canvas below a sprite only while it is hidden.
+ * Overlapping sprites have to be hidden in the reverse order they were shown.
+ */
+class DogSprite
+{
+  public:
+    DogSprite (const byte *pic_adress, const byte *mask_adress, byte *background);
+#if !defined(DOG_NO_HEAP)
+    DogSprite (const byte *pic_adress, const byte *mask_adress);
+#endif
+    ~DogSprite ();
+    static unsigned int backgroundBytes (const byte *pic_adress);
+    void show (DogCanvas &canvas, int x, int y);
+    void moveTo (int x, int y);
+    void moveBy (int dx, int dy);
+    void hide (void);
+    bool isVisible (void);
+    int getX (void);
+    int getY (void);
+    bool getDirtyArea (int &x0, int &y0, int &x1, int &y1);
+
+  private:
+    const byte *picture;
+    const byte *mask;  // NULL = set pixels of the picture
+    byte *background;  // canvas bytes below the sprite, (pages + 1) * width
+    bool backgroundOwned;
+    byte width, height;
+    DogCanvas *canvas;  // NULL while hidden
+    int posX, posY;
+    int dirtyX0, dirtyY0, dirtyX1, dirtyY1;  // old and new position of the last change, empty if start > end
+
+    void save (void);
+    void restore (void);
+    void draw (void);
+    void add_dirty (void);
+};
+
+#endif